@@ -0,0 +1,549 @@
+/*
+havgsd.cpp
+
+ABOUT
+
+Helper process of havGSD, scans project files outside of CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../havGSDProtocol.hpp"
+#include "../havGSDScanGovernor.hpp"
+#include "../havGSDScanScheduler.hpp"
+#include "../havGSDScanner.hpp"
+
+#include <wx/filename.h>
+#include <wx/init.h>
+#include <wx/string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct havGSDCachedFile
+{
+    std::int64_t mModificationTime;
+    std::int64_t mSize;
+    std::vector<havGSDFileItem> mFileItems;
+};
+
+// Scan results of files, the least recently used ones are dropped once the cache holds too many
+// - Results are only valid for the keyword list and description length they were created with, which are part of the key
+// - Every file counts as one entry plus one per task
+class havGSDFileCache
+{
+public:
+    static constexpr std::size_t MaxEntries = 1000000;
+
+    static std::string MakeKey(const std::string& keywordSignature, const std::string& path)
+    {
+        return keywordSignature + '\0' + path;
+    }
+
+    bool Find(const std::string& key, std::int64_t modificationTime, std::int64_t size, std::vector<havGSDFileItem>& fileItems)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto foundFile = mFiles.find(key);
+        if (foundFile == mFiles.end() ||
+            foundFile->second.mFile.mModificationTime != modificationTime ||
+            foundFile->second.mFile.mSize != size)
+        {
+            return false;
+        }
+
+        mUsage.splice(mUsage.begin(), mUsage, foundFile->second.mUsage);
+        fileItems = foundFile->second.mFile.mFileItems;
+        return true;
+    }
+
+    void Insert(const std::string& key, std::int64_t modificationTime, std::int64_t size, const std::vector<havGSDFileItem>& fileItems)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        Erase(key);
+
+        mUsage.push_front(key);
+        mFiles[key] = havGSDCacheEntry{ havGSDCachedFile{ modificationTime, size, fileItems }, mUsage.begin() };
+        mEntryCount += 1 + fileItems.size();
+
+        while (mEntryCount > MaxEntries && !mUsage.empty())
+        {
+            Erase(mUsage.back());
+        }
+    }
+
+private:
+    struct havGSDCacheEntry
+    {
+        havGSDCachedFile mFile;
+        std::list<std::string>::iterator mUsage;
+    };
+
+    void Erase(const std::string& key)
+    {
+        auto foundFile = mFiles.find(key);
+        if (foundFile == mFiles.end())
+        {
+            return;
+        }
+
+        mEntryCount -= 1 + foundFile->second.mFile.mFileItems.size();
+        mUsage.erase(foundFile->second.mUsage);
+        mFiles.erase(foundFile);
+    }
+
+    std::mutex mMutex;
+    std::list<std::string> mUsage; // Most recently used first
+    std::unordered_map<std::string, havGSDCacheEntry> mFiles;
+    std::size_t mEntryCount = 0;
+};
+
+// Serves scan requests of all CodeLite instances of the user
+// - Results are cached per file and keyword list, and reused while the modification time and size of the file stay the same
+// - Every client gets its own thread, the cache is shared
+class havGSDScanDaemon
+{
+public:
+    // Exit after this many seconds without clients
+    static constexpr int IdleTimeoutSeconds = 10 * 60;
+
+    havGSDScanDaemon() = default;
+
+    ~havGSDScanDaemon()
+    {
+        if (mListenFd >= 0)
+        {
+            close(mListenFd);
+            unlink(mSocketPath.c_str());
+        }
+
+        if (mLockFd >= 0)
+        {
+            close(mLockFd);
+        }
+    }
+
+    bool Listen(const std::string& socketPath)
+    {
+        mSocketPath = socketPath;
+
+        // Only one helper per socket
+        const std::string lockPath = socketPath + ".lock";
+
+        mLockFd = open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW, 0600);
+        if (mLockFd < 0 || flock(mLockFd, LOCK_EX | LOCK_NB) != 0)
+        {
+            return false;
+        }
+
+        sockaddr_un address;
+        if (!havGSDSocket::MakeAddress(socketPath, address))
+        {
+            return false;
+        }
+
+        // Remove the socket of a helper which didn't exit cleanly
+        unlink(socketPath.c_str());
+
+        mListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (mListenFd < 0)
+        {
+            return false;
+        }
+
+        if (bind(mListenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close(mListenFd);
+            mListenFd = -1;
+            return false;
+        }
+
+        chmod(socketPath.c_str(), 0600);
+
+        return listen(mListenFd, 16) == 0;
+    }
+
+    void Run()
+    {
+        auto lastActivity = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            pollfd pollFd = { mListenFd, POLLIN, 0 };
+
+            int ready = poll(&pollFd, 1, 1000);
+
+            if (ready > 0)
+            {
+                int clientFd = accept(mListenFd, nullptr, nullptr);
+
+                if (clientFd >= 0)
+                {
+                    ++mClientCount;
+
+                    std::thread(&havGSDScanDaemon::HandleClient, this, clientFd).detach();
+                }
+            }
+
+            if (mClientCount > 0)
+            {
+                lastActivity = std::chrono::steady_clock::now();
+            }
+            else if (std::chrono::steady_clock::now() - lastActivity > std::chrono::seconds(IdleTimeoutSeconds))
+            {
+                return;
+            }
+        }
+    }
+
+private:
+    void HandleClient(int clientFd)
+    {
+        havGSDSocket client(clientFd);
+        client.DisableSigPipe();
+
+        // The directory of the socket is private already, this also rejects processes of other users which got hold of it
+        if (!client.IsPeerCurrentUser())
+        {
+            --mClientCount;
+            return;
+        }
+
+        havGSDMessageType type;
+        std::string payload;
+
+        // Messages of another protocol version are refused by ReceiveMessage(), the client then scans by itself
+        if (!client.ReceiveMessage(type, payload) || type != havGSDMessageType::Hello ||
+            !client.SendMessage(havGSDMessageType::Hello, std::string()))
+        {
+            --mClientCount;
+            return;
+        }
+
+        while (client.ReceiveMessage(type, payload))
+        {
+            if (type != havGSDMessageType::Scan || !HandleScan(client, payload))
+            {
+                break;
+            }
+        }
+
+        --mClientCount;
+    }
+
+    bool HandleScan(havGSDSocket& client, const std::string& payload)
+    {
+        havGSDMessageReader reader(payload);
+
+        std::uint32_t keywordCount = 0;
+        if (!reader.ReadUInt32(keywordCount))
+        {
+            return false;
+        }
+
+        std::vector<wxString> keywords;
+        std::string keywordSignature;
+        std::string text;
+
+        for (std::uint32_t index = 0; index < keywordCount; ++index)
+        {
+            if (!reader.ReadString(text))
+            {
+                return false;
+            }
+
+            keywords.push_back(wxString::FromUTF8(text.data(), text.size()));
+            keywordSignature += text;
+            keywordSignature += '\n';
+        }
+
+        // Cached descriptions are cut to this length as well
+        std::uint32_t maxDescriptionLength = 0;
+        if (!reader.ReadUInt32(maxDescriptionLength))
+        {
+            return false;
+        }
+
+        keywordSignature += std::to_string(maxDescriptionLength);
+
+        std::uint32_t openEditorCount = 0;
+        std::uint32_t cpuBudget = 0;
+        std::uint32_t buildRunning = 0;
+        std::uint32_t fileCount = 0;
+
+        if (!reader.ReadString(text) ||
+            !reader.ReadUInt32(openEditorCount) ||
+            !reader.ReadUInt32(cpuBudget) ||
+            !reader.ReadUInt32(buildRunning) ||
+            !reader.ReadUInt32(fileCount))
+        {
+            return false;
+        }
+
+        const wxString projectName = wxString::FromUTF8(text.data(), text.size());
+
+        std::vector<wxFileName> files;
+        std::string path;
+
+        for (std::uint32_t index = 0; index < fileCount; ++index)
+        {
+            if (!reader.ReadString(path))
+            {
+                return false;
+            }
+
+            files.emplace_back(wxString::FromUTF8(path.data(), path.size()));
+        }
+
+        havGSDScanner scanner;
+        const bool hasKeywords = scanner.Init(keywords, maxDescriptionLength);
+
+        havGSDMessageWriter writer;
+        std::vector<havGSDFileItem> fileItems;
+
+        // Returns false once the client is gone or started a new scan
+        auto sendFileResult = [&](const wxFileName& file) {
+            path = file.GetFullPath().ToStdString(wxConvUTF8);
+            fileItems.clear();
+
+            struct stat fileStat;
+            if (hasKeywords && stat(path.c_str(), &fileStat) == 0)
+            {
+#ifdef __APPLE__
+                const std::int64_t modificationTime = static_cast<std::int64_t>(fileStat.st_mtimespec.tv_sec) * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+#else
+                const std::int64_t modificationTime = static_cast<std::int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+#endif
+                const std::int64_t size = static_cast<std::int64_t>(fileStat.st_size);
+
+                // Clients with other keywords don't share the results
+                const std::string key = havGSDFileCache::MakeKey(keywordSignature, path);
+
+                if (!mCache.Find(key, modificationTime, size, fileItems))
+                {
+                    scanner.ScanFile(file, projectName, fileItems);
+                    mCache.Insert(key, modificationTime, size, fileItems);
+                }
+            }
+
+            if (fileItems.empty())
+            {
+                return true;
+            }
+
+            writer.Clear();
+            writer.WriteString(path);
+            writer.WriteUInt32(static_cast<std::uint32_t>(fileItems.size()));
+
+            for (const auto& fileItem : fileItems)
+            {
+                unsigned long lineNumber = 0;
+                fileItem.mLine.ToULong(&lineNumber);
+
+                writer.WriteString(fileItem.mType.ToStdString(wxConvUTF8));
+                writer.WriteUInt32(static_cast<std::uint32_t>(lineNumber));
+                writer.WriteString(fileItem.mDescription.ToStdString(wxConvUTF8));
+            }
+
+            return client.SendMessage(havGSDMessageType::FileResult, writer.GetPayload());
+        };
+
+        // The open editors are sent before the modification times of the other files are read
+        const std::size_t openEditorsEnd = std::min<std::size_t>(openEditorCount, files.size());
+        std::size_t index = 0;
+
+        for (; index < openEditorsEnd; ++index)
+        {
+            if (!sendFileResult(files[index]))
+            {
+                return false;
+            }
+        }
+
+        if (openEditorsEnd > 0 && !client.SendMessage(havGSDMessageType::GroupDone, std::string()))
+        {
+            return false;
+        }
+
+        // Then the recently modified files, newest first, and the rest in project order
+        const std::atomic<bool> cancel(false);
+        const std::size_t recentlyModifiedEnd = index + havGSDScanScheduler().MoveRecentlyModifiedToFront(files, index, cancel);
+
+        for (; index < recentlyModifiedEnd; ++index)
+        {
+            if (!sendFileResult(files[index]))
+            {
+                return false;
+            }
+        }
+
+        if (recentlyModifiedEnd > openEditorsEnd && !client.SendMessage(havGSDMessageType::GroupDone, std::string()))
+        {
+            return false;
+        }
+
+        // The rest is paced like the background pass of a scan inside CodeLite, during builds the client is waited for to report their end
+        havGSDScanGovernor scanGovernor;
+        scanGovernor.SetCpuBudget(static_cast<int>(cpuBudget));
+        scanGovernor.Begin();
+
+        bool paused = buildRunning != 0;
+
+        for (; index < files.size(); ++index)
+        {
+            if (!ReceiveThrottle(client, paused) || !WaitForBuild(client, paused) || !scanGovernor.Throttle(cancel) ||
+                !sendFileResult(files[index]))
+            {
+                return false;
+            }
+        }
+
+        return client.SendMessage(havGSDMessageType::ScanDone, std::string());
+    }
+
+    // Reads the throttle messages the client sent during the scan, returns false once the client is gone
+    bool ReceiveThrottle(havGSDSocket& client, bool& buildRunning, int timeout = 0)
+    {
+        pollfd pollFd = { client.GetFd(), POLLIN, 0 };
+
+        int ready = 0;
+        do
+        {
+            ready = poll(&pollFd, 1, timeout);
+        } while (ready < 0 && errno == EINTR);
+
+        if (ready <= 0)
+        {
+            return ready == 0;
+        }
+
+        havGSDMessageType type;
+        std::string payload;
+        std::uint32_t value = 0;
+
+        if (!client.ReceiveMessage(type, payload) || type != havGSDMessageType::Throttle || !havGSDMessageReader(payload).ReadUInt32(value))
+        {
+            return false;
+        }
+
+        buildRunning = value != 0;
+        return true;
+    }
+
+    // Blocks until the client reports the end of the build, returns false once the client is gone
+    bool WaitForBuild(havGSDSocket& client, bool& buildRunning)
+    {
+        while (buildRunning)
+        {
+            if (!ReceiveThrottle(client, buildRunning, -1))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::string mSocketPath;
+    int mListenFd = -1;
+    int mLockFd = -1;
+    std::atomic<int> mClientCount{ 0 };
+
+    havGSDFileCache mCache;
+};
+
+int main()
+{
+    // Don't hold on to anything inherited from CodeLite
+    for (int fd = 3; fd < 1024; ++fd)
+    {
+        close(fd);
+    }
+
+    int nullFd = open("/dev/null", O_RDWR);
+    if (nullFd >= 0)
+    {
+        dup2(nullFd, STDIN_FILENO);
+        dup2(nullFd, STDOUT_FILENO);
+        dup2(nullFd, STDERR_FILENO);
+
+        if (nullFd > STDERR_FILENO)
+        {
+            close(nullFd);
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    wxInitializer initializer;
+    if (!initializer.IsOk())
+    {
+        return 1;
+    }
+
+    // The socket isn't created in a directory other users can access
+    if (!havGSDSocket::MakePrivateDirectory(havGSDSocket::GetDefaultDirectory()))
+    {
+        return 1;
+    }
+
+    havGSDScanDaemon scanDaemon;
+    if (!scanDaemon.Listen(havGSDSocket::GetDefaultPath()))
+    {
+        // Another helper is already running
+        return 0;
+    }
+
+    scanDaemon.Run();
+
+    return 0;
+}
@@ -41,24 +41,31 @@ SOFTWARE.
 
 #include "havGSD.hpp"
 
+#include "havGSDIoUringReader.hpp"
+#include "havGSDScanDaemonClient.hpp"
+#include "havGSDScanScheduler.hpp"
 #include "havGSDSettingsDialog.hpp"
 
 #include "event_notifier.h"
+#include "file_logger.h"
 #include "ieditor.h"
 #include "imanager.h"
 #include "project.h"
 #include "workspace.h"
 
+#include <wx/arrstr.h>
 #include <wx/colour.h>
 #include <wx/filefn.h>
-#include <wx/regex.h>
-#include <wx/txtstrm.h>
 #include <wx/sizer.h>
+#include <wx/stopwatch.h>
 #include <wx/variant.h>
 #include <wx/vector.h>
-#include <wx/wfstream.h>
 #include <wx/xrc/xmlres.h>
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <numeric>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -76,8 +83,12 @@ CL_PLUGIN_API PluginInfo* GetPluginInfo()
 
 CL_PLUGIN_API int GetPluginInterfaceVersion() { return PLUGIN_INTERFACE_VERSION; }
 
-havGSD::havGSD(IManager* manager) : IPlugin(manager)
+havGSD::havGSD(IManager* manager)
+    : IPlugin(manager), mTaskListModel(nullptr), mScanScope(havGSDScanScope::Project), mViewMode(havGSDViewMode::List), mCancelScan(false), mScanRunning(false), mScanGeneration(0), mScanDaemonUnavailable(false), mTaskListCtrl(nullptr),
+      mFilterCtrl(nullptr), mScanScopeChoice(nullptr), mViewModeChoice(nullptr), mSummaryText(nullptr), mHavGSDPanel(nullptr), mShowAbsoluteFilePath(false)
 {
+    wxStopWatch stopWatch;
+
     m_longName = _("havGSD for CodeLite");
     m_shortName = wxT("havGSD");
 
@@ -89,38 +100,38 @@ havGSD::havGSD(IManager* manager) : IPlugin(manager)
     EventNotifier::Get()->Bind(wxEVT_FILE_SAVED, &havGSD::OnFileSaved, this);
     EventNotifier::Get()->Bind(wxEVT_FILE_RENAMED, &havGSD::OnFileRenamed, this);
     EventNotifier::Get()->Bind(wxEVT_FILE_DELETED, &havGSD::OnFileDeleted, this);
+    EventNotifier::Get()->Bind(wxEVT_BUILD_STARTED, &havGSD::OnBuildStarted, this);
+    EventNotifier::Get()->Bind(wxEVT_BUILD_ENDED, &havGSD::OnBuildEnded, this);
 
+    // Only an empty panel is registered with the output view here, the task list and the settings
+    // are created when the tab is shown for the first time or a C++ workspace is loaded
     mHavGSDPanel = new wxPanel(m_mgr->GetMainPanel(), wxID_ANY, wxDefaultPosition,
                                wxDefaultSize, wxTAB_TRAVERSAL, m_mgr->GetMainPanel()->GetName());
 
-    wxBoxSizer* boxSizer = new wxBoxSizer(wxHORIZONTAL);
+    wxBoxSizer* boxSizer = new wxBoxSizer(wxVERTICAL);
     mHavGSDPanel->SetSizer(boxSizer);
 
-    mThemedListCtrlForTasks = new clThemedListCtrl(mHavGSDPanel, wxID_ANY, wxDefaultPosition,
-                                                   wxDLG_UNIT(mHavGSDPanel, wxSize(-1, -1)),
-                                                   wxDV_COLUMN_WIDTH_NEVER_SHRINKS | wxDV_ROW_LINES | wxDV_SINGLE | get_border_simple_theme_aware_bit());
-
-    mThemedListCtrlForTasks->Bind(wxEVT_COMMAND_DATAVIEW_ITEM_ACTIVATED, &havGSD::OnItemActived, this);
+    mHavGSDPanel->Bind(wxEVT_SHOW, &havGSD::OnPanelShown, this);
 
-    boxSizer->Add(mThemedListCtrlForTasks, 1, wxALL | wxEXPAND, WXC_FROM_DIP(5));
+    mTabToggler.reset(new clTabTogglerHelper(_("havGSD"), mHavGSDPanel, _("havGSD"), NULL));
 
-    mThemedListCtrlForTasks->AddHeader(_("Type"), wxNullBitmap, wxCOL_WIDTH_AUTOSIZE);
-    mThemedListCtrlForTasks->AddHeader(_("Description"), wxNullBitmap, wxCOL_WIDTH_AUTOSIZE);
-    mThemedListCtrlForTasks->AddHeader(_("Project"), wxNullBitmap, wxCOL_WIDTH_AUTOSIZE);
-    mThemedListCtrlForTasks->AddHeader(_("File"), wxNullBitmap, wxCOL_WIDTH_AUTOSIZE);
-    mThemedListCtrlForTasks->AddHeader(_("Line"), wxNullBitmap, wxCOL_WIDTH_AUTOSIZE);
+    clDEBUG() << "havGSD: plugin loaded in" << stopWatch.Time() << "ms";
+}
 
-    mTabToggler.reset(new clTabTogglerHelper(_("havGSD"), mHavGSDPanel, _("havGSD"), NULL));
+havGSD::~havGSD()
+{
+    // Normally already stopped in UnPlug()
+    mGitIndexWatcher.Stop();
 
-    mHavGSDSettings = std::make_unique<havGSDSettings>();
-    mHavGSDSettings->Load(GetHavGSDSettingsFile());
+    mCancelScan = true;
+    mScanGovernor.Wake();
 
-    havGSDSettingsObject& settingsObject = mHavGSDSettings->GetSettingsObject();
-    mShowAbsoluteFilePath = settingsObject.mShowAbsoluteFilePath;
+    if (mScanThread.joinable())
+    {
+        mScanThread.join();
+    }
 }
 
-havGSD::~havGSD() {}
-
 void havGSD::CreateToolBar(clToolBarGeneric* toolbar) { wxUnusedVar(toolbar); }
 
 void havGSD::CreatePluginMenu(wxMenu* pluginsMenu)
@@ -132,7 +143,7 @@ void havGSD::CreatePluginMenu(wxMenu* pluginsMenu)
         [&](wxCommandEvent& event) {
             std::unordered_map<wxString, wxColour> keywordColors;
 
-            havGSDSettingsObject& settingsObject = mHavGSDSettings->GetSettingsObject();
+            havGSDSettingsObject& settingsObject = GetSettings().GetSettingsObject();
 
             for (const auto& settingEntry : settingsObject.mSettingEntries)
             {
@@ -140,11 +151,22 @@ void havGSD::CreatePluginMenu(wxMenu* pluginsMenu)
             }
 
             bool showAbsoluteFilePath = settingsObject.mShowAbsoluteFilePath;
-
-            havGSDSettingsDialog settingsDialog(EventNotifier::Get()->TopFrame(), mHavGSDSettings->GetDefaultKeywordsWithColors(), keywordColors, showAbsoluteFilePath);
+            bool useScanDaemon = settingsObject.mUseScanDaemon;
+            bool useGitIndex = settingsObject.mUseGitIndex;
+            int maxDescriptionLength = settingsObject.mMaxDescriptionLength;
+            int cpuBudget = settingsObject.mCpuBudget;
+            wxString baseRef = settingsObject.mBaseRef;
+
+            havGSDSettingsDialog settingsDialog(EventNotifier::Get()->TopFrame(), GetSettings().GetDefaultKeywordsWithColors(), keywordColors, showAbsoluteFilePath, useScanDaemon,
+                                                useGitIndex, maxDescriptionLength, cpuBudget, baseRef);
             if (settingsDialog.ShowModal() == wxID_OK)
             {
                 settingsObject.mShowAbsoluteFilePath = showAbsoluteFilePath;
+                settingsObject.mUseScanDaemon = useScanDaemon;
+                settingsObject.mUseGitIndex = useGitIndex;
+                settingsObject.mMaxDescriptionLength = maxDescriptionLength;
+                settingsObject.mCpuBudget = cpuBudget;
+                settingsObject.mBaseRef = baseRef;
 
                 settingsObject.mSettingEntries.clear();
 
@@ -155,7 +177,10 @@ void havGSD::CreatePluginMenu(wxMenu* pluginsMenu)
 
                 mShowAbsoluteFilePath = showAbsoluteFilePath;
 
-                mHavGSDSettings->Save(GetHavGSDSettingsFile());
+                // Give the helper another chance, it may have been installed meanwhile
+                mScanDaemonUnavailable = false;
+
+                GetSettings().Save(GetHavGSDSettingsFile());
 
                 RefreshKeywordList();
             }
@@ -165,6 +190,8 @@ void havGSD::CreatePluginMenu(wxMenu* pluginsMenu)
 
 void havGSD::UnPlug()
 {
+    StopScan();
+
     EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_LOADED, &havGSD::OnWorkspaceOpened, this);
     EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_CLOSED, &havGSD::OnWorkspaceClosed, this);
     EventNotifier::Get()->Unbind(wxEVT_ACTIVE_PROJECT_CHANGED, &havGSD::OnActiveProjectChanged, this);
@@ -173,16 +200,34 @@ void havGSD::UnPlug()
     EventNotifier::Get()->Unbind(wxEVT_FILE_SAVED, &havGSD::OnFileSaved, this);
     EventNotifier::Get()->Unbind(wxEVT_FILE_RENAMED, &havGSD::OnFileRenamed, this);
     EventNotifier::Get()->Unbind(wxEVT_FILE_DELETED, &havGSD::OnFileDeleted, this);
+    EventNotifier::Get()->Unbind(wxEVT_BUILD_STARTED, &havGSD::OnBuildStarted, this);
+    EventNotifier::Get()->Unbind(wxEVT_BUILD_ENDED, &havGSD::OnBuildEnded, this);
 
-    mThemedListCtrlForTasks->Unbind(wxEVT_COMMAND_DATAVIEW_ITEM_ACTIVATED, &havGSD::OnItemActived, this);
+    mHavGSDPanel->Unbind(wxEVT_SHOW, &havGSD::OnPanelShown, this);
+
+    if (mTaskListCtrl)
+    {
+        mFilterCtrl->Unbind(wxEVT_TEXT, &havGSD::OnFilterChanged, this);
+        mScanScopeChoice->Unbind(wxEVT_CHOICE, &havGSD::OnScanScopeChanged, this);
+        mViewModeChoice->Unbind(wxEVT_CHOICE, &havGSD::OnViewModeChanged, this);
+        mTaskListCtrl->Unbind(wxEVT_COMMAND_DATAVIEW_ITEM_ACTIVATED, &havGSD::OnItemActived, this);
+        mTaskListCtrl->Unbind(wxEVT_DATAVIEW_COLUMN_HEADER_CLICK, &havGSD::OnColumnHeaderClicked, this);
+    }
 
     mTabToggler.reset();
 }
 
 void havGSD::OnWorkspaceOpened(clWorkspaceEvent& event)
 {
+    mLatencyTracker.Start("WorkspaceOpened");
+
     mWorkspaceType = event.GetWorkspaceType();
 
+    if (mWorkspaceType == "C++")
+    {
+        CreateTaskList();
+    }
+
     RefreshKeywordList();
 
     event.Skip(true);
@@ -190,13 +235,15 @@ void havGSD::OnWorkspaceOpened(clWorkspaceEvent& event)
 
 void havGSD::OnWorkspaceClosed(clWorkspaceEvent& event)
 {
-    mThemedListCtrlForTasks->DeleteAllItems();
+    StopScan();
 
     event.Skip(true);
 }
 
 void havGSD::OnActiveProjectChanged(clProjectSettingsEvent& event)
 {
+    mLatencyTracker.Start("ActiveProjectChanged");
+
     RefreshKeywordList();
 
     event.Skip(true);
@@ -204,6 +251,8 @@ void havGSD::OnActiveProjectChanged(clProjectSettingsEvent& event)
 
 void havGSD::OnProjectRenamed(clCommandEvent& event)
 {
+    mLatencyTracker.Start("ProjectRenamed");
+
     RefreshKeywordList();
 
     event.Skip(true);
@@ -211,6 +260,8 @@ void havGSD::OnProjectRenamed(clCommandEvent& event)
 
 void havGSD::OnProjectRemoved(clCommandEvent& event)
 {
+    mLatencyTracker.Start("ProjectRemoved");
+
     RefreshKeywordList();
 
     event.Skip(true);
@@ -218,13 +269,17 @@ void havGSD::OnProjectRemoved(clCommandEvent& event)
 
 void havGSD::OnFileSaved(clCommandEvent& event)
 {
-    RefreshKeywordList();
+    mLatencyTracker.Start("FileSaved");
+
+    RescanFiles({ event.GetFileName() });
 
     event.Skip(true);
 }
 
 void havGSD::OnFileRenamed(clFileSystemEvent& event)
 {
+    mLatencyTracker.Start("FileRenamed");
+
     RefreshKeywordList();
 
     event.Skip(true);
@@ -232,251 +287,1127 @@ void havGSD::OnFileRenamed(clFileSystemEvent& event)
 
 void havGSD::OnFileDeleted(clFileSystemEvent& event)
 {
+    mLatencyTracker.Start("FileDeleted");
+
     RefreshKeywordList();
 
     event.Skip(true);
 }
 
+void havGSD::OnBuildStarted(clBuildEvent& event)
+{
+    mScanGovernor.SetBuildRunning(true);
+
+    event.Skip(true);
+}
+
+void havGSD::OnBuildEnded(clBuildEvent& event)
+{
+    mScanGovernor.SetBuildRunning(false);
+
+    event.Skip(true);
+}
+
+void havGSD::OnPanelShown(wxShowEvent& event)
+{
+    if (event.IsShown())
+    {
+        CreateTaskList();
+    }
+
+    event.Skip(true);
+}
+
 void havGSD::OnItemActived(wxDataViewEvent& event)
 {
     wxDataViewItem item = event.GetItem();
     CHECK_ITEM_RET(item);
 
-    wxFileName fileName = mFileItems[mThemedListCtrlForTasks->ItemToRow(item)].mFilePath;
+    if (!mDisplayedScanResults)
+    {
+        return;
+    }
+
+    std::size_t row = mTaskListModel->GetRow(item);
+
+    if (row >= mTaskListModel->GetRowCount())
+    {
+        return;
+    }
+
+    const havGSDTaskRow taskRow = mTaskListModel->GetTaskRow(row);
+
+    if (taskRow.mGroupIndex >= 0)
+    {
+        // Expand or collapse the group, its tasks are only added to the list while expanded
+        const wxString groupKey = mTaskListModel->GetGroup(taskRow.mGroupIndex).GetKey();
+
+        if (mExpandedGroups.erase(groupKey) == 0)
+        {
+            mExpandedGroups.insert(groupKey);
+        }
+
+        ShowTasks();
+
+        if (row < mTaskListModel->GetRowCount())
+        {
+            mTaskListCtrl->EnsureVisible(mTaskListModel->GetItem(static_cast<unsigned int>(row)));
+        }
+
+        return;
+    }
+
+    const havGSDFileItem& fileItem = mDisplayedScanResults->mFileItems[taskRow.mItemId];
+
+    wxFileName fileName = fileItem.mFilePath;
 
     if (fileName.Exists())
     {
         ProjectPtr project = m_mgr->GetWorkspace()->GetActiveProject();
 
-        m_mgr->OpenFile(fileName.GetFullPath(), project->GetName(), wxAtoi(mFileItems[mThemedListCtrlForTasks->ItemToRow(item)].mLine) - 1);
+        m_mgr->OpenFile(fileName.GetFullPath(), project->GetName(), wxAtoi(fileItem.mLine) - 1);
     }
 }
 
-wxString havGSD::GetHavGSDSettingsFile()
+void havGSD::OnFilterChanged(wxCommandEvent& event)
 {
-    wxFileName filename(clStandardPaths::Get().GetUserDataDir(), "havgsd.conf");
-    filename.AppendDir("config");
-    return filename.GetFullPath();
+    // Every keystroke filters right away, the list control only asks for the rows it shows
+    ShowTasks();
+
+    event.Skip(true);
+}
+
+void havGSD::OnScanScopeChanged(wxCommandEvent& event)
+{
+    mScanScope = static_cast<havGSDScanScope>(mScanScopeChoice->GetSelection());
+
+    mLatencyTracker.Start("ScanScopeChanged");
+
+    RefreshKeywordList();
+
+    event.Skip(true);
 }
 
-void havGSD::SearchKeywordsInFiles(const std::vector<wxFileName>& files, const std::vector<wxString>& keywords, const wxString& projectName)
+void havGSD::OnViewModeChanged(wxCommandEvent& event)
 {
-    // Reset stored file items
-    mFileItems.clear();
+    mViewMode = static_cast<havGSDViewMode>(mViewModeChoice->GetSelection());
 
-    if (keywords.empty())
+    ShowTasks();
+
+    event.Skip(true);
+}
+
+void havGSD::OnColumnHeaderClicked(wxDataViewEvent& event)
+{
+    havGSDSortColumn column;
+
+    // Columns in the order of the headers, the description can't be sorted
+    switch (event.GetColumn())
     {
-        // Keyword list is empty
+    case 0:
+        column = havGSDSortColumn::Type;
+        break;
+    case 2:
+        column = havGSDSortColumn::Project;
+        break;
+    case 3:
+        column = havGSDSortColumn::FileName;
+        break;
+    case 4:
+        column = havGSDSortColumn::Line;
+        break;
+    default:
         return;
     }
 
-    // Build regex to match keywords in comments
-    wxString regexPattern = "\\b(" + wxJoin(keywords, '|') + ")\\b";
+    auto foundSortKey = std::find_if(mSortKeys.begin(), mSortKeys.end(),
+        [column](const havGSDSortKey& sortKey) { return sortKey.mColumn == column; });
+
+    if (foundSortKey == mSortKeys.begin() && foundSortKey != mSortKeys.end())
+    {
+        // Clicking the primary column again reverses the order
+        foundSortKey->mAscending = !foundSortKey->mAscending;
+    }
+    else
+    {
+        // The clicked column becomes the primary key, the previous keys break ties
+        if (foundSortKey != mSortKeys.end())
+        {
+            mSortKeys.erase(foundSortKey);
+        }
+
+        mSortKeys.insert(mSortKeys.begin(), { column, true });
+    }
+
+    ShowTasks();
+}
+
+void havGSD::OnScanResultsPublished()
+{
+    havGSDSnapshotPublisher<havGSDScanResults>::Snapshot scanResults = mScanResultsPublisher.Acquire();
 
-    // Case-insensitive regex
-    wxRegEx regex;
-    if (!regex.Compile(regexPattern, wxRE_ICASE))
+    if (scanResults == mDisplayedScanResults)
     {
-        // Invalid generated regex
+        // Already shown
         return;
     }
 
-    for (const auto& file : files)
+    // Partial results of the same scan only grow, so in the plain list without a filter only the new items need to be appended
+    bool appendNewItems = mViewMode == havGSDViewMode::List &&
+                          mSortKeys.empty() &&
+                          mFilterCtrl->IsEmpty() &&
+                          mDisplayedScanResults &&
+                          mDisplayedScanResults->mGeneration == scanResults->mGeneration &&
+                          mDisplayedScanResults->mFileItems.size() <= scanResults->mFileItems.size();
+
+    std::size_t firstNewIndex = appendNewItems ? mDisplayedScanResults->mFileItems.size() : 0;
+
+    mDisplayedScanResults = scanResults;
+
+    if (appendNewItems)
     {
-        if (!file.FileExists())
+        mTaskListModel->SetFileItems(&mDisplayedScanResults->mFileItems);
+
+        for (std::size_t index = firstNewIndex; index < mDisplayedScanResults->mFileItems.size(); ++index)
         {
-            // File doesn't exist
-            continue;
+            AppendTask(static_cast<std::uint32_t>(index));
         }
 
-        wxFileInputStream fileStream(file.GetFullPath());
-        if (!fileStream.IsOk())
+        mTaskListModel->Update();
+
+        UpdateSummary();
+    }
+    else
+    {
+        ShowTasks();
+    }
+
+    // Time from the event which triggered the scan until its final results are in the task list
+    wxString eventName;
+    havGSDLatencyTracker::havGSDLatencyReport latencyReport;
+
+    if (mDisplayedScanResults->mComplete && mLatencyTracker.Stop(mDisplayedScanResults->mGeneration, eventName, latencyReport))
+    {
+        clDEBUG() << "havGSD:" << eventName << "shown in the task list after" << latencyReport.mLatency << "ms"
+                  << wxString::Format("(p50 %ld ms, p99 %ld ms over the last %zu events)",
+                                      latencyReport.mMedian, latencyReport.m99thPercentile, latencyReport.mSampleCount);
+    }
+}
+
+void havGSD::ShowTasks()
+{
+    mTaskListModel->Clear();
+    mTaskListModel->SetShowAbsoluteFilePath(mShowAbsoluteFilePath);
+    mTaskListModel->SetTypeColours(GetTypeColours());
+
+    if (mDisplayedScanResults)
+    {
+        mTaskListModel->SetFileItems(&mDisplayedScanResults->mFileItems);
+
+        AppendRows();
+    }
+
+    mTaskListModel->Update();
+
+    UpdateSummary();
+}
+
+void havGSD::AppendRows()
+{
+    const havGSDScanResults& scanResults = *mDisplayedScanResults;
+
+    wxString filter = mFilterCtrl->GetValue();
+
+    havGSDTaskIndex::ItemIds filteredItems;
+    const havGSDTaskIndex::ItemIds* filteredItemIds = nullptr;
+
+    if (!filter.Trim(false).Trim().IsEmpty())
+    {
+        filteredItems = scanResults.mTaskIndex.Query(filter);
+        filteredItemIds = &filteredItems;
+    }
+
+    if (mViewMode == havGSDViewMode::List)
+    {
+        if (!filteredItemIds)
         {
-            // Couldn't open file
-            continue;
+            filteredItems.resize(scanResults.mFileItems.size());
+            std::iota(filteredItems.begin(), filteredItems.end(), 0);
         }
 
-        wxTextInputStream textStream(fileStream);
-        wxString line;
-        std::size_t lineNumber = 0;
-        bool inBlockComment = false;
-        wxString commentBlock;
-        std::vector<std::pair<std::size_t, wxString>> blockLines; // Store line numbers and contents
+        AppendTasks(std::move(filteredItems));
+        return;
+    }
 
-        // Track which keywords have already been processed for each line
-        std::unordered_map<std::size_t, std::unordered_set<wxString>> matchedKeywordsPerLine;
+    // Without a filter the groups are counted already, with a filter only the matching items are counted
+    havGSDTaskCounters filteredTaskCounters;
+    const havGSDTaskCounters* taskCounters = &scanResults.mTaskCounters;
 
-        while (!fileStream.Eof())
+    if (filteredItemIds)
+    {
+        for (std::uint32_t itemId : *filteredItemIds)
         {
-            line = textStream.ReadLine();
-            ++lineNumber;
+            filteredTaskCounters.Add(scanResults.mFileItems[itemId]);
+        }
 
-            // Check for single-line comments
-            if (line.Contains("//"))
-            {
-                if (regex.Matches(line))
-                {
-                    // Capture all matches in the line
-                    for (std::size_t index = 0; index < regex.GetMatchCount(); ++index)
-                    {
-                        wxString matchedText = regex.GetMatch(line, index);
-
-                        // Check if the matched word is actually in the keyword list
-                        if (std::find(keywords.begin(), keywords.end(), matchedText) == keywords.end())
-                        {
-                            // Ignore unknown matches
-                            continue;
-                        }
-
-                        // Ensure we store multiple occurrences but avoid redundant re-processing
-                        if (matchedKeywordsPerLine[lineNumber].count(matchedText) == 0)
-                        {
-                            matchedKeywordsPerLine[lineNumber].insert(matchedText);
-
-                            havGSDFileItem fileItem;
-                            fileItem.mType = matchedText.Upper().Trim(false).Trim();
-                            fileItem.mProjectName = projectName;
-                            fileItem.mFileName = file.GetFullName();
-                            fileItem.mFilePath = file.GetFullPath();
-                            fileItem.mDescription = line.Trim(false).Trim();
-                            fileItem.mLine = wxString::Format("%zu", lineNumber);
-
-                            mFileItems.push_back(fileItem);
-                        }
-                    }
-                }
+        taskCounters = &filteredTaskCounters;
+    }
 
-                // Skip further processing for single-line comments
-                continue;
+    if (mViewMode == havGSDViewMode::GroupByFile)
+    {
+        for (const auto& [filePath, count] : taskCounters->GetFileCounts())
+        {
+            if (AppendGroup(wxEmptyString, filePath, count))
+            {
+                AppendTasks(GetGroupItemIds(wxEmptyString, filePath, filteredItemIds));
             }
+        }
 
-            // Detect start of a multi-line block comment (/* ... */)
-            if (line.Contains("/*"))
-            {
-                inBlockComment = true;
-                commentBlock = line + "\n"; // Start collecting comment block
-                blockLines.clear(); // Reset stored block lines
-                blockLines.emplace_back(lineNumber, line); // Store first line
+        return;
+    }
 
-                continue;
-            }
+    for (const auto& [type, count] : taskCounters->GetTypeCounts())
+    {
+        if (!AppendGroup(type, wxEmptyString, count))
+        {
+            continue;
+        }
 
-            // If inside a block comment, collect lines and store line numbers
-            if (inBlockComment)
-            {
-                commentBlock += line + "\n"; // Append current line
-                blockLines.emplace_back(lineNumber, line); // Store line with number
+        // The files of a keyword are only counted once it is expanded
+        havGSDTaskCounters keywordTaskCounters;
 
-                // Detect end of block comment (*/)
-                if (line.Contains("*/"))
-                {
-                    inBlockComment = false;
+        for (std::uint32_t itemId : GetGroupItemIds(type, wxEmptyString, filteredItemIds))
+        {
+            keywordTaskCounters.Add(scanResults.mFileItems[itemId]);
+        }
 
-                    // Search for keywords inside each stored line
-                    for (const auto& [commentLineNumber, commentLine] : blockLines)
-                    {
-                        if (regex.Matches(commentLine))
-                        {
-                            for (std::size_t index = 0; index < regex.GetMatchCount(); ++index)
-                            {
-                                wxString matchedText = regex.GetMatch(commentLine, index);
-
-                                // Check if the match is known
-                                if (std::find(keywords.begin(), keywords.end(), matchedText) == keywords.end())
-                                {
-                                    // Skip unknown matches
-                                    continue;
-                                }
-
-                                // Ensure we capture multiple occurrences but avoid duplicate entries from multi-line processing
-                                if (matchedKeywordsPerLine[commentLineNumber].count(matchedText) == 0)
-                                {
-                                    matchedKeywordsPerLine[commentLineNumber].insert(matchedText);
-
-                                    wxString tempCommentLine = commentLine;
-
-                                    havGSDFileItem fileItem;
-                                    fileItem.mType = matchedText.Upper().Trim(false).Trim();
-                                    fileItem.mProjectName = projectName;
-                                    fileItem.mFileName = file.GetFullName();
-                                    fileItem.mFilePath = file.GetFullPath();
-                                    fileItem.mDescription = tempCommentLine.Trim(false).Trim();
-                                    fileItem.mLine = wxString::Format("%zu", commentLineNumber);
-
-                                    mFileItems.push_back(fileItem);
-                                }
-                            }
-                        }
-                    }
-                }
+        for (const auto& [filePath, fileCount] : keywordTaskCounters.GetFileCounts())
+        {
+            if (AppendGroup(type, filePath, fileCount))
+            {
+                AppendTasks(GetGroupItemIds(type, filePath, filteredItemIds));
             }
         }
     }
 }
 
-void havGSD::RefreshKeywordList()
+void havGSD::AppendTask(std::uint32_t itemId)
+{
+    mTaskListModel->AppendTask(itemId);
+}
+
+void havGSD::AppendTasks(havGSDTaskIndex::ItemIds itemIds)
 {
-    mThemedListCtrlForTasks->DeleteAllItems();
+    // The file column shows either the file name or the path
+    std::vector<havGSDSortKey> sortKeys = mSortKeys;
 
-    if (!m_mgr->GetWorkspace()->IsOpen() ||
-        mWorkspaceType != "C++")
+    for (auto& sortKey : sortKeys)
     {
-        return;
+        if (sortKey.mColumn == havGSDSortColumn::FileName && mShowAbsoluteFilePath)
+        {
+            sortKey.mColumn = havGSDSortColumn::FilePath;
+        }
     }
 
-    ProjectPtr project = m_mgr->GetWorkspace()->GetActiveProject();
+    mDisplayedScanResults->mSortKeys.Sort(itemIds, sortKeys);
 
-    if (project)
+    for (std::uint32_t itemId : itemIds)
+    {
+        AppendTask(itemId);
+    }
+}
+
+// Returns true if the group is expanded
+bool havGSD::AppendGroup(const wxString& type, const wxString& filePath, std::size_t count)
+{
+    havGSDTaskGroup group{ type, filePath, count, false };
+
+    group.mExpanded = mExpandedGroups.count(group.GetKey()) != 0;
+
+    const bool expanded = group.mExpanded;
+
+    mTaskListModel->AppendGroup(std::move(group));
+
+    return expanded;
+}
+
+havGSDTaskIndex::ItemIds havGSD::GetGroupItemIds(const wxString& type, const wxString& filePath, const havGSDTaskIndex::ItemIds* filteredItemIds)
+{
+    havGSDTaskIndex::ItemIds itemIds = mDisplayedScanResults->mTaskIndex.Find(type, filePath);
+
+    if (filteredItemIds)
     {
-        wxVector<wxVariant> items;
-        std::vector<wxFileName> files;
+        havGSDTaskIndex::ItemIds intersection;
+        std::set_intersection(itemIds.begin(), itemIds.end(), filteredItemIds->begin(), filteredItemIds->end(), std::back_inserter(intersection));
+        itemIds.swap(intersection);
+    }
+
+    return itemIds;
+}
 
-        project->GetFilesAsVectorOfFileName(files, true);
+std::unordered_map<wxString, wxColour> havGSD::GetTypeColours()
+{
+    std::unordered_map<wxString, wxColour> typeColours;
+
+    // Purple is the default color of keywords, their type keeps the default text color
+    for (const auto& [keyword, settingEntry] : GetSettings().GetSettingsObject().mSettingEntries)
+    {
+        wxColour columnColor(settingEntry.mColor);
 
-        if (!files.empty())
+        if (columnColor != wxColour(128, 0, 128))
         {
-            havGSDSettingsObject& settingsObject = mHavGSDSettings->GetSettingsObject();
+            typeColours.emplace(keyword, columnColor);
+        }
+    }
 
-            std::vector<wxString> keywords;
+    return typeColours;
+}
 
-            for (const auto& settingEntry : settingsObject.mSettingEntries)
-            {
-                keywords.push_back(settingEntry.second.mKeyword);
-            }
+void havGSD::UpdateSummary()
+{
+    if (mDisplayedScanResults && !mDisplayedScanResults->mError.IsEmpty())
+    {
+        mSummaryText->SetLabel(mDisplayedScanResults->mError);
+        return;
+    }
 
-            SearchKeywordsInFiles(files, keywords, project->GetName());
+    const wxString& baseRef = mLastScanRequest.mBaseRef;
 
-            if (!mFileItems.empty())
-            {
-                for (std::vector<havGSDFileItem>::size_type index = 0; index < mFileItems.size(); ++index)
-                {
-                    havGSDFileItem fileItem = mFileItems[index];
+    if (!mDisplayedScanResults || mDisplayedScanResults->mTaskCounters.GetTotal() == 0)
+    {
+        mSummaryText->SetLabel(baseRef.IsEmpty() ? _("No tasks") : wxString::Format(_("No tasks added since %s"), baseRef));
+        return;
+    }
 
-                    items.clear();
+    const havGSDTaskCounters& taskCounters = mDisplayedScanResults->mTaskCounters;
 
-                    items.push_back(fileItem.mType);
-                    items.push_back(fileItem.mDescription);
-                    items.push_back(fileItem.mProjectName);
-                    items.push_back((mShowAbsoluteFilePath == true) ? fileItem.mFilePath : fileItem.mFileName);
-                    items.push_back(fileItem.mLine);
+    wxString summary = wxString::Format(_("%zu tasks in %zu files"), taskCounters.GetTotal(), taskCounters.GetFileCounts().size());
 
-                    mThemedListCtrlForTasks->AppendItem(items);
+    if (!baseRef.IsEmpty())
+    {
+        summary += " " + wxString::Format(_("added since %s"), baseRef);
+    }
 
-                    wxColour columnColor(128, 0, 128);
+    for (const auto& [type, count] : taskCounters.GetTypeCounts())
+    {
+        summary += wxString::Format("   %s: %zu", type, count);
+    }
 
-                    auto foundSettingEntry = settingsObject.mSettingEntries.find(fileItem.mType);
+    // The header of the task list has no sort indicator
+    for (std::size_t index = 0; index < mSortKeys.size(); ++index)
+    {
+        summary += (index == 0) ? "   " + _("Sorted by") + " " : wxString(", ");
 
-                    if (foundSettingEntry != settingsObject.mSettingEntries.end())
-                    {
-                        columnColor = foundSettingEntry->second.mColor;
-                    }
+        switch (mSortKeys[index].mColumn)
+        {
+        case havGSDSortColumn::Type:
+            summary += _("Type");
+            break;
+        case havGSDSortColumn::Project:
+            summary += _("Project");
+            break;
+        case havGSDSortColumn::FileName:
+        case havGSDSortColumn::FilePath:
+            summary += _("File");
+            break;
+        case havGSDSortColumn::Line:
+            summary += _("Line");
+            break;
+        }
 
-                    if (columnColor != wxColour(128, 0, 128))
-                    {
-                        mThemedListCtrlForTasks->SetItemTextColour(mThemedListCtrlForTasks->RowToItem(index), columnColor, 0);
-                    }
-                }
-            }
+        if (!mSortKeys[index].mAscending)
+        {
+            summary += " " + _("(descending)");
         }
     }
+
+    mSummaryText->SetLabel(summary);
+}
+
+void havGSD::CreateTaskList()
+{
+    if (mTaskListCtrl)
+    {
+        // Already created
+        return;
+    }
+
+    wxStopWatch stopWatch;
+
+    wxBoxSizer* filterSizer = new wxBoxSizer(wxHORIZONTAL);
+    mHavGSDPanel->GetSizer()->Add(filterSizer, 0, wxLEFT | wxRIGHT | wxTOP | wxEXPAND, WXC_FROM_DIP(5));
+
+    mFilterCtrl = new wxTextCtrl(mHavGSDPanel, wxID_ANY);
+    mFilterCtrl->SetHint(_("Filter tasks... (type: file: project: owner:)"));
+    mFilterCtrl->Bind(wxEVT_TEXT, &havGSD::OnFilterChanged, this);
+
+    filterSizer->Add(mFilterCtrl, 1, wxRIGHT | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+
+    // Same order as havGSDScanScope
+    wxArrayString scanScopes;
+    scanScopes.Add(_("All Tasks"));
+    scanScopes.Add(_("New on Branch"));
+
+    mScanScopeChoice = new wxChoice(mHavGSDPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, scanScopes);
+    mScanScopeChoice->SetSelection(static_cast<int>(mScanScope));
+    mScanScopeChoice->Bind(wxEVT_CHOICE, &havGSD::OnScanScopeChanged, this);
+
+    filterSizer->Add(mScanScopeChoice, 0, wxRIGHT | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+
+    // Same order as havGSDViewMode
+    wxArrayString viewModes;
+    viewModes.Add(_("List"));
+    viewModes.Add(_("Group by File"));
+    viewModes.Add(_("Group by Keyword and File"));
+
+    mViewModeChoice = new wxChoice(mHavGSDPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, viewModes);
+    mViewModeChoice->SetSelection(static_cast<int>(mViewMode));
+    mViewModeChoice->Bind(wxEVT_CHOICE, &havGSD::OnViewModeChanged, this);
+
+    filterSizer->Add(mViewModeChoice, 0, wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+
+    // A virtual list, the rows are only IDs of tasks and their text is looked up as they are drawn
+    mTaskListCtrl = new wxDataViewCtrl(mHavGSDPanel, wxID_ANY, wxDefaultPosition,
+                                       wxDLG_UNIT(mHavGSDPanel, wxSize(-1, -1)),
+                                       wxDV_ROW_LINES | wxDV_SINGLE | get_border_simple_theme_aware_bit());
+
+    mTaskListModel = new havGSDTaskListModel();
+    mTaskListCtrl->AssociateModel(mTaskListModel);
+    mTaskListModel->DecRef();
+
+    mTaskListCtrl->Bind(wxEVT_COMMAND_DATAVIEW_ITEM_ACTIVATED, &havGSD::OnItemActived, this);
+    mTaskListCtrl->Bind(wxEVT_DATAVIEW_COLUMN_HEADER_CLICK, &havGSD::OnColumnHeaderClicked, this);
+
+    mHavGSDPanel->GetSizer()->Add(mTaskListCtrl, 1, wxALL | wxEXPAND, WXC_FROM_DIP(5));
+
+    mSummaryText = new wxStaticText(mHavGSDPanel, wxID_ANY, wxEmptyString);
+
+    mHavGSDPanel->GetSizer()->Add(mSummaryText, 0, wxLEFT | wxRIGHT | wxBOTTOM | wxEXPAND, WXC_FROM_DIP(5));
+
+    mTaskListCtrl->AppendTextColumn(_("Type"), havGSDTaskListModel::TypeColumn, wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE);
+    mTaskListCtrl->AppendTextColumn(_("Description"), havGSDTaskListModel::DescriptionColumn, wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE);
+    mTaskListCtrl->AppendTextColumn(_("Project"), havGSDTaskListModel::ProjectColumn, wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE);
+    mTaskListCtrl->AppendTextColumn(_("File"), havGSDTaskListModel::FileColumn, wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE);
+    mTaskListCtrl->AppendTextColumn(_("Line"), havGSDTaskListModel::LineColumn, wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE);
+
+    mHavGSDPanel->Layout();
+
+    // The task list needs the keyword colors
+    GetSettings();
+
+    UpdateSummary();
+
+    clDEBUG() << "havGSD: task list created in" << stopWatch.Time() << "ms";
+}
+
+havGSDSettings& havGSD::GetSettings()
+{
+    // Parsing the configuration file (and creating it on first run) is deferred until the settings are needed
+    if (!mHavGSDSettings)
+    {
+        mHavGSDSettings = std::make_unique<havGSDSettings>();
+        mHavGSDSettings->Load(GetHavGSDSettingsFile());
+
+        havGSDSettingsObject& settingsObject = mHavGSDSettings->GetSettingsObject();
+        mShowAbsoluteFilePath = settingsObject.mShowAbsoluteFilePath;
+    }
+
+    return *mHavGSDSettings;
+}
+
+wxString havGSD::GetHavGSDSettingsFile()
+{
+    wxFileName filename(clStandardPaths::Get().GetUserDataDir(), "havgsd.conf");
+    filename.AppendDir("config");
+    return filename.GetFullPath();
+}
+
+// Runs on the scan thread
+void havGSD::SearchKeywordsInFiles(havGSDScanRequest& request, std::size_t generation)
+{
+    if (request.mBaseResults)
+    {
+        RescanFilesInResults(request, generation);
+        return;
+    }
+
+    if (!request.mBaseRef.IsEmpty())
+    {
+        SearchKeywordsInBranch(request, generation);
+        return;
+    }
+
+#ifdef HAVGSD_HAS_SCAN_DAEMON
+    if (!request.mScanDaemonPath.IsEmpty() && SearchKeywordsWithScanDaemon(request, generation))
+    {
+        return;
+    }
+#endif
+
+    std::vector<wxFileName>& files = request.mFiles;
+    const wxString& projectName = request.mProjectName;
+
+    havGSDScanner scanner;
+    scanner.SetCancel(&mCancelScan);
+
+    if (!scanner.Init(request.mKeywords, request.mMaxDescriptionLength))
+    {
+        // No valid keywords, nothing to find
+        PublishScanResults(generation, std::vector<havGSDFileItem>(), true);
+        return;
+    }
+
+    std::vector<havGSDFileItem> fileItems;
+    std::size_t publishedFileItemCount = 0;
+
+    std::size_t index = 0;
+
+    // Partial results after each priority group, unless it found nothing or no files are left
+    auto publishGroup = [&]() {
+        if (index < files.size() && fileItems.size() > publishedFileItemCount)
+        {
+            PublishScanResults(generation, fileItems, false);
+            publishedFileItemCount = fileItems.size();
+        }
+    };
+
+    // The files of open editors are at the front already, their tasks are shown before any other file is looked at
+    const std::size_t openEditorsEnd = std::min(request.mSchedule.mOpenEditorCount, files.size());
+
+    for (; index < openEditorsEnd; ++index)
+    {
+        if (mCancelScan)
+        {
+            // A newer scan replaces this one
+            return;
+        }
+
+        scanner.ScanFile(files[index], projectName, fileItems);
+    }
+
+    publishGroup();
+
+    // The recently modified files follow, finding them reads the modification time of every remaining file
+    request.mSchedule.mRecentlyModifiedCount = havGSDScanScheduler().MoveRecentlyModifiedToFront(files, index, mCancelScan);
+    const std::size_t recentlyModifiedEnd = index + request.mSchedule.mRecentlyModifiedCount;
+
+    for (; index < recentlyModifiedEnd; ++index)
+    {
+        if (mCancelScan)
+        {
+            return;
+        }
+
+        scanner.ScanFile(files[index], projectName, fileItems);
+    }
+
+    publishGroup();
+
+    // The remaining files are scanned in the background, paced by the governor
+    mScanGovernor.Begin();
+
+#ifdef HAVGSD_USE_IO_URING
+    // The remaining files are most likely not in the page cache, read them in batches
+    havGSDIoUringReader ioUringReader;
+
+    if (ioUringReader.Init())
+    {
+        ioUringReader.ReadFiles(files, index, mCancelScan,
+            [&](std::size_t fileIndex, const char* data, std::size_t size) {
+                mScanGovernor.Throttle(mCancelScan);
+                scanner.ScanBuffer(files[fileIndex], data, size, projectName, fileItems);
+            },
+            [&](std::size_t fileIndex) {
+                // Fall back to the portable reader
+                scanner.ScanFile(files[fileIndex], projectName, fileItems);
+            });
+
+        index = files.size();
+    }
+#endif
+
+    for (; index < files.size(); ++index)
+    {
+        if (!mScanGovernor.Throttle(mCancelScan))
+        {
+            return;
+        }
+
+        scanner.ScanFile(files[index], projectName, fileItems);
+    }
+
+    if (mCancelScan)
+    {
+        return;
+    }
+
+    PublishScanResults(generation, std::move(fileItems), true);
+}
+
+// Runs on the scan thread, only the lines added since the base ref are scanned
+void havGSD::SearchKeywordsInBranch(const havGSDScanRequest& request, std::size_t generation)
+{
+    havGSDScanner scanner;
+    scanner.SetCancel(&mCancelScan);
+
+    if (!scanner.Init(request.mKeywords, request.mMaxDescriptionLength))
+    {
+        PublishScanResults(generation, std::vector<havGSDFileItem>(), true);
+        return;
+    }
+
+    // Opened here, the rescans of the request reuse it
+    havGSDBranchDelta& branchDelta = *request.mBranchDelta;
+    if (!branchDelta.Open(request.mProjectPath, request.mBaseRef, mCancelScan))
+    {
+        if (mCancelScan)
+        {
+            return;
+        }
+
+        PublishScanError(generation, wxString::Format(_("Couldn't compare with %s, the project isn't in a git repository or the ref is unknown"), request.mBaseRef));
+        return;
+    }
+
+    std::vector<havGSDFileItem> fileItems;
+    std::vector<bool> addedLines;
+
+    // Compared in the background like the remaining files of a full scan, files unchanged since the base ref are skipped without reading them
+    mScanGovernor.Begin();
+
+    for (std::size_t index = 0; index < request.mFiles.size(); ++index)
+    {
+        if (mCancelScan || (index > 0 && !mScanGovernor.Throttle(mCancelScan)))
+        {
+            return;
+        }
+
+        const wxFileName& file = request.mFiles[index];
+
+        if (branchDelta.GetAddedLines(file.GetFullPath(), addedLines, mCancelScan))
+        {
+            scanner.ScanFile(file, request.mProjectName, fileItems, addedLines.empty() ? nullptr : &addedLines);
+        }
+    }
+
+    if (mCancelScan)
+    {
+        return;
+    }
+
+    PublishScanResults(generation, std::move(fileItems), true);
+}
+
+#ifdef HAVGSD_HAS_SCAN_DAEMON
+// Runs on the scan thread, returns false if the helper process couldn't complete the scan
+bool havGSD::SearchKeywordsWithScanDaemon(const havGSDScanRequest& request, std::size_t generation)
+{
+    havGSDScanDaemonClient scanDaemonClient(request.mScanDaemonPath);
+    if (!scanDaemonClient.Connect(mCancelScan))
+    {
+        if (!mCancelScan)
+        {
+            clWARNING() << "havGSD: scan helper" << request.mScanDaemonPath << "isn't available, scanning inside CodeLite for this session";
+            mScanDaemonUnavailable = true;
+        }
+
+        return false;
+    }
+
+    std::vector<havGSDFileItem> fileItems;
+    std::size_t publishedFileItemCount = 0;
+
+    bool completed = scanDaemonClient.Scan(request.mFiles, request.mSchedule.mOpenEditorCount, request.mKeywords, request.mMaxDescriptionLength, request.mProjectName, mScanGovernor, mCancelScan, fileItems,
+        [&]() {
+            // Publish partial results after each priority group
+            if (fileItems.size() > publishedFileItemCount)
+            {
+                PublishScanResults(generation, fileItems, false);
+                publishedFileItemCount = fileItems.size();
+            }
+        });
+
+    if (!completed)
+    {
+        return false;
+    }
+
+    if (!mCancelScan)
+    {
+        PublishScanResults(generation, std::move(fileItems), true);
+    }
+
+    return true;
+}
+#endif
+
+// Runs on the scan thread
+void havGSD::RescanFilesInResults(const havGSDScanRequest& request, std::size_t generation)
+{
+    const havGSDScanResults& baseResults = *request.mBaseResults;
+
+    havGSDScanner scanner;
+    scanner.SetCancel(&mCancelScan);
+
+    if (!scanner.Init(request.mKeywords, request.mMaxDescriptionLength))
+    {
+        return;
+    }
+
+    // Only the added lines are scanned again when the scan is limited to the branch, the full scan opened the comparison already
+    havGSDBranchDelta* branchDelta = request.mBranchDelta.get();
+    if (!request.mBaseRef.IsEmpty() && (!branchDelta || (!branchDelta->IsOpen() && !branchDelta->Open(request.mProjectPath, request.mBaseRef, mCancelScan))))
+    {
+        return;
+    }
+
+    std::unordered_set<wxString> filePaths;
+    std::vector<havGSDFileItem> newFileItems;
+    std::vector<bool> addedLines;
+
+    // Many files change at once after checkouts and pulls, only the first one is scanned right away
+    mScanGovernor.Begin();
+
+    for (const wxFileName& file : request.mFiles)
+    {
+        if (mCancelScan || (!filePaths.empty() && !mScanGovernor.Throttle(mCancelScan)))
+        {
+            return;
+        }
+
+        filePaths.insert(file.GetFullPath());
+
+        if (request.mBaseRef.IsEmpty())
+        {
+            scanner.ScanFile(file, request.mProjectName, newFileItems);
+        }
+        else if (branchDelta->GetAddedLines(file.GetFullPath(), addedLines, mCancelScan))
+        {
+            scanner.ScanFile(file, request.mProjectName, newFileItems, addedLines.empty() ? nullptr : &addedLines);
+        }
+    }
+
+    std::shared_ptr<havGSDScanResults> scanResults = std::make_shared<havGSDScanResults>();
+    scanResults->mGeneration = generation;
+    scanResults->mTaskCounters = baseResults.mTaskCounters;
+    scanResults->mFileItems.reserve(baseResults.mFileItems.size() + newFileItems.size());
+
+    // The new items take the place of the old items of the file, only the replaced items are counted and indexed again
+    havGSDTaskIndex::ItemIds baseItemIds;
+    baseItemIds.reserve(scanResults->mFileItems.capacity());
+
+    bool newFileItemsAdded = false;
+
+    auto addNewFileItems = [&]() {
+        scanResults->mFileItems.insert(scanResults->mFileItems.end(), newFileItems.begin(), newFileItems.end());
+        baseItemIds.insert(baseItemIds.end(), newFileItems.size(), havGSDTaskIndex::NewItemId);
+        newFileItemsAdded = true;
+    };
+
+    for (std::uint32_t baseItemId = 0; baseItemId < baseResults.mFileItems.size(); ++baseItemId)
+    {
+        const havGSDFileItem& fileItem = baseResults.mFileItems[baseItemId];
+
+        if (filePaths.count(fileItem.mFilePath) == 0)
+        {
+            scanResults->mFileItems.push_back(fileItem);
+            baseItemIds.push_back(baseItemId);
+            continue;
+        }
+
+        scanResults->mTaskCounters.Remove(fileItem);
+
+        if (!newFileItemsAdded)
+        {
+            addNewFileItems();
+        }
+    }
+
+    if (!newFileItemsAdded)
+    {
+        addNewFileItems();
+    }
+
+    scanResults->mTaskCounters.Add(newFileItems, 0, newFileItems.size());
+    scanResults->mTaskIndex.Update(baseResults.mTaskIndex, scanResults->mFileItems, baseItemIds);
+    scanResults->mSortKeys.Update(baseResults.mSortKeys, scanResults->mFileItems, baseItemIds);
+    scanResults->mComplete = true;
+
+    if (mCancelScan)
+    {
+        return;
+    }
+
+    mScanResultsPublisher.Publish(std::move(scanResults));
+
+    CallAfter(&havGSD::OnScanResultsPublished);
+}
+
+void havGSD::StartScan(havGSDScanRequest request)
+{
+    CancelScan();
+
+    const std::size_t generation = ++mScanGeneration;
+
+    mLatencyTracker.SetGeneration(generation);
+
+    mScanGovernor.SetCpuBudget(GetSettings().GetSettingsObject().mCpuBudget);
+
+    mScanRunning = true;
+
+    mScanThread = std::thread(
+        [this, request = std::move(request), generation]() mutable {
+            // Nothing may escape the thread, an uncaught exception would terminate CodeLite
+            try
+            {
+                // Full scans of the project start with the open editors, the remaining files are ordered once they are scanned
+                if (!request.mBaseResults && request.mBaseRef.IsEmpty())
+                {
+                    havGSDScanScheduler scanScheduler;
+
+                    for (const wxFileName& file : request.mOpenEditorFiles)
+                    {
+                        scanScheduler.AddOpenEditor(file);
+                    }
+
+                    request.mSchedule.mOpenEditorCount = scanScheduler.MoveOpenEditorsToFront(request.mFiles);
+                }
+
+                SearchKeywordsInFiles(request, generation);
+            }
+            catch (const std::exception& exception)
+            {
+                PublishScanError(generation, wxString::Format(_("The scan failed: %s"), exception.what()));
+            }
+
+            mScanRunning = false;
+
+            CallAfter(&havGSD::OnScanFinished);
+        });
+}
+
+void havGSD::CancelScan()
+{
+    mCancelScan = true;
+    mScanGovernor.Wake();
+
+    if (mScanThread.joinable())
+    {
+        mScanThread.join();
+    }
+
+    mCancelScan = false;
+    mScanRunning = false;
+}
+
+void havGSD::StopScan()
+{
+    CancelScan();
+
+    mLastScanFilePaths.clear();
+    mLastScanRequest.mBranchDelta.reset();
+
+    mGitIndexWatcher.Stop();
+    mGitIndexChanges.clear();
+
+    // Drop the results of the stopped scan, so pending notifications won't bring them back
+    mScanResultsPublisher.Publish(std::make_shared<const havGSDScanResults>());
+    mDisplayedScanResults = mScanResultsPublisher.Acquire();
+
+    if (mTaskListCtrl)
+    {
+        mTaskListModel->Clear();
+        mTaskListModel->Update();
+        UpdateSummary();
+    }
+}
+
+// Runs on the scan thread
+void havGSD::PublishScanResults(std::size_t generation, std::vector<havGSDFileItem> fileItems, bool complete)
+{
+    std::shared_ptr<havGSDScanResults> scanResults = std::make_shared<havGSDScanResults>();
+    scanResults->mGeneration = generation;
+    scanResults->mComplete = complete;
+    scanResults->mFileItems = std::move(fileItems);
+    scanResults->mTaskIndex.Build(scanResults->mFileItems);
+    scanResults->mSortKeys.Build(scanResults->mFileItems);
+
+    // Partial results of the same scan only grow, only the new items need to be counted
+    havGSDSnapshotPublisher<havGSDScanResults>::Snapshot previousResults = mScanResultsPublisher.Acquire();
+    std::size_t firstNewIndex = 0;
+
+    if (previousResults->mGeneration == generation &&
+        previousResults->mFileItems.size() <= scanResults->mFileItems.size())
+    {
+        scanResults->mTaskCounters = previousResults->mTaskCounters;
+        firstNewIndex = previousResults->mFileItems.size();
+    }
+
+    scanResults->mTaskCounters.Add(scanResults->mFileItems, firstNewIndex, scanResults->mFileItems.size());
+
+    mScanResultsPublisher.Publish(std::move(scanResults));
+
+    // Let the UI pick up the latest snapshot
+    CallAfter(&havGSD::OnScanResultsPublished);
+}
+
+void havGSD::PublishScanError(std::size_t generation, const wxString& error)
+{
+    std::shared_ptr<havGSDScanResults> scanResults = std::make_shared<havGSDScanResults>();
+    scanResults->mGeneration = generation;
+    scanResults->mComplete = true;
+    scanResults->mError = error;
+
+    mScanResultsPublisher.Publish(std::move(scanResults));
+
+    CallAfter(&havGSD::OnScanResultsPublished);
+}
+
+void havGSD::RefreshKeywordList()
+{
+    StopScan();
+
+    if (!mTaskListCtrl ||
+        !m_mgr->GetWorkspace()->IsOpen() ||
+        mWorkspaceType != "C++")
+    {
+        return;
+    }
+
+    ProjectPtr project = m_mgr->GetWorkspace()->GetActiveProject();
+
+    if (project)
+    {
+        havGSDScanRequest request;
+
+        project->GetFilesAsVectorOfFileName(request.mFiles, true);
+
+        if (!request.mFiles.empty())
+        {
+            // Scan files of open editors and recently modified files first, only the editors are collected here
+            for (IEditor* editor : m_mgr->GetAllEditors())
+            {
+                request.mOpenEditorFiles.push_back(editor->GetFileName());
+            }
+
+            havGSDSettingsObject& settingsObject = GetSettings().GetSettingsObject();
+
+            for (const auto& settingEntry : settingsObject.mSettingEntries)
+            {
+                request.mKeywords.push_back(settingEntry.second.mKeyword);
+            }
+
+            request.mMaxDescriptionLength = static_cast<std::size_t>(std::max(settingsObject.mMaxDescriptionLength, 0));
+            request.mProjectName = project->GetName();
+            request.mProjectPath = project->GetFileName().GetPath();
+
+            if (mScanScope == havGSDScanScope::Branch)
+            {
+                request.mBaseRef = settingsObject.mBaseRef;
+                request.mBranchDelta = std::make_shared<havGSDBranchDelta>();
+            }
+
+#ifdef HAVGSD_HAS_SCAN_DAEMON
+            if (settingsObject.mUseScanDaemon && !mScanDaemonUnavailable)
+            {
+                request.mScanDaemonPath = wxFileName(clStandardPaths::Get().GetPluginsDirectory(), "havgsd").GetFullPath();
+            }
+#endif
+
+            // Saved files of this scan are rescanned on their own
+            mLastScanRequest = request;
+            mLastScanRequest.mFiles.clear();
+            mLastScanRequest.mOpenEditorFiles.clear();
+
+            for (const wxFileName& file : request.mFiles)
+            {
+                mLastScanFilePaths.insert(file.GetFullPath());
+            }
+
+            if (settingsObject.mUseGitIndex)
+            {
+                WatchGitIndex(request.mProjectPath);
+            }
+
+            StartScan(std::move(request));
+        }
+    }
+}
+
+void havGSD::RescanFiles(const std::vector<wxString>& filePaths)
+{
+    havGSDSnapshotPublisher<havGSDScanResults>::Snapshot scanResults = mScanResultsPublisher.Acquire();
+
+    // Scan the whole project again while a scan is running, the results are incomplete or a file isn't part of them
+    bool rescanProject = mScanRunning || scanResults->mGeneration == 0 || scanResults->mGeneration != mScanGeneration;
+
+    for (const wxString& filePath : filePaths)
+    {
+        rescanProject = rescanProject || mLastScanFilePaths.count(filePath) == 0;
+    }
+
+    if (rescanProject)
+    {
+        RefreshKeywordList();
+        return;
+    }
+
+    havGSDScanRequest request = mLastScanRequest;
+    request.mBaseResults = scanResults;
+
+    for (const wxString& filePath : filePaths)
+    {
+        request.mFiles.push_back(wxFileName(filePath));
+    }
+
+    StartScan(std::move(request));
+}
+
+void havGSD::WatchGitIndex(const wxString& directory)
+{
+    // Reading and comparing the index runs on the watcher thread, the changes are handled by the UI
+    mGitIndexWatcher.Start(directory, [this](std::vector<wxString> filePaths) {
+        CallAfter(&havGSD::OnGitIndexChanged, std::move(filePaths));
+    });
+}
+
+void havGSD::OnGitIndexChanged(std::vector<wxString> filePaths)
+{
+    // Tracked files, whose content changed and which are part of the project
+    for (const wxString& filePath : filePaths)
+    {
+        if (mLastScanFilePaths.count(filePath) != 0)
+        {
+            mGitIndexChanges.insert(filePath);
+        }
+    }
+
+    // Rescanned once the running scan is finished
+    if (!mScanRunning)
+    {
+        RescanGitIndexChanges();
+    }
+}
+
+void havGSD::OnScanFinished()
+{
+    if (!mScanRunning)
+    {
+        RescanGitIndexChanges();
+    }
+}
+
+void havGSD::RescanGitIndexChanges()
+{
+    if (mGitIndexChanges.empty())
+    {
+        return;
+    }
+
+    std::vector<wxString> changedFilePaths(mGitIndexChanges.begin(), mGitIndexChanges.end());
+    mGitIndexChanges.clear();
+
+    mLatencyTracker.Start("GitIndexChanged");
+
+    RescanFiles(changedFilePaths);
 }
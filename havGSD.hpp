@@ -46,17 +46,36 @@ SOFTWARE.
 #include "clFileSystemEvent.h"
 #include "cl_command_event.h"
 #include "clTabTogglerHelper.h"
-#include "clThemedListCtrl.h"
 #include "plugin.h"
 
+#include <wx/choice.h>
+#include <wx/dataview.h>
 #include <wx/filename.h>
 #include <wx/panel.h>
+#include <wx/stattext.h>
+#include <wx/textctrl.h>
 #include <wx/string.h>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
+#include "havGSDBranchDelta.hpp"
+#include "havGSDGitIndexWatcher.hpp"
+#include "havGSDLatencyTracker.hpp"
+#include "havGSDScanGovernor.hpp"
+#include "havGSDProtocol.hpp"
+#include "havGSDScanner.hpp"
+#include "havGSDScanScheduler.hpp"
 #include "havGSDSettings.hpp"
+#include "havGSDSnapshot.hpp"
+#include "havGSDTaskCounters.hpp"
+#include "havGSDTaskIndex.hpp"
+#include "havGSDTaskListModel.hpp"
+#include "havGSDTaskSortKeys.hpp"
 
 #ifdef WXC_FROM_DIP
 #undef WXC_FROM_DIP
@@ -67,14 +86,50 @@ SOFTWARE.
 #define WXC_FROM_DIP(x) x
 #endif
 
-struct havGSDFileItem
+struct havGSDScanResults
 {
-    wxString mType;
+    // Identifies the scan that produced the results, partial results of the same scan only ever grow
+    std::size_t mGeneration = 0;
+    std::vector<havGSDFileItem> mFileItems;
+    havGSDTaskIndex mTaskIndex;
+    havGSDTaskSortKeys mSortKeys;
+    havGSDTaskCounters mTaskCounters;
+    bool mComplete = false; // Final results of the scan
+    wxString mError;        // Why the scan couldn't run, shown instead of the summary
+};
+
+// Everything a scan needs, copied on the UI thread before the scan thread starts
+struct havGSDScanRequest
+{
+    std::vector<wxFileName> mFiles;
+    std::vector<wxFileName> mOpenEditorFiles; // Scanned first, the scan thread schedules mFiles
+    havGSDScanSchedule mSchedule;             // Filled in while the scan thread orders mFiles
+    std::vector<wxString> mKeywords;
+    std::size_t mMaxDescriptionLength = 0;
     wxString mProjectName;
-    wxString mFileName;
-    wxString mFilePath;
-    wxString mDescription;
-    wxString mLine;
+    wxString mProjectPath;    // Directory of the project file
+    wxString mScanDaemonPath; // Empty to scan inside CodeLite
+    wxString mBaseRef;        // Only tasks added since this git ref are found, empty for all tasks
+
+    // Comparison with mBaseRef, opened by the full scan and shared with the rescans of this request, one scan thread uses it at a time
+    std::shared_ptr<havGSDBranchDelta> mBranchDelta;
+
+    // If set, only mFiles are scanned and their items replaced in these results
+    havGSDSnapshotPublisher<havGSDScanResults>::Snapshot mBaseResults;
+};
+
+// Same order as the scope choice
+enum class havGSDScanScope
+{
+    Project,
+    Branch
+};
+
+enum class havGSDViewMode
+{
+    List,
+    GroupByFile,
+    GroupByKeywordAndFile
 };
 
 class havGSD : public IPlugin
@@ -96,11 +151,22 @@ protected:
     void OnFileSaved(clCommandEvent& event);
     void OnFileRenamed(clFileSystemEvent& event);
     void OnFileDeleted(clFileSystemEvent& event);
+    void OnBuildStarted(clBuildEvent& event);
+    void OnBuildEnded(clBuildEvent& event);
+    void OnPanelShown(wxShowEvent& event);
     void OnItemActived(wxDataViewEvent& event);
+    void OnFilterChanged(wxCommandEvent& event);
+    void OnScanScopeChanged(wxCommandEvent& event);
+    void OnViewModeChanged(wxCommandEvent& event);
+    void OnColumnHeaderClicked(wxDataViewEvent& event);
+    void OnGitIndexChanged(std::vector<wxString> filePaths);
+    void OnScanResultsPublished();
+    void OnScanFinished();
 
 private:
     std::unique_ptr<havGSDSettings> mHavGSDSettings;
 
+    havGSDSettings& GetSettings();
     wxString GetHavGSDSettingsFile();
 
     wxBorder get_border_simple_theme_aware_bit()
@@ -112,13 +178,81 @@ private:
 #endif
     }
 
-    void SearchKeywordsInFiles(const std::vector<wxFileName>& files, const std::vector<wxString>& keywords, const wxString& projectName);
+    void SearchKeywordsInFiles(havGSDScanRequest& request, std::size_t generation);
+    void SearchKeywordsInBranch(const havGSDScanRequest& request, std::size_t generation);
+#ifdef HAVGSD_HAS_SCAN_DAEMON
+    bool SearchKeywordsWithScanDaemon(const havGSDScanRequest& request, std::size_t generation);
+#endif
+
+    void RescanFilesInResults(const havGSDScanRequest& request, std::size_t generation);
+
+    void StartScan(havGSDScanRequest request);
+    void CancelScan();
+    void StopScan();
 
+    void PublishScanResults(std::size_t generation, std::vector<havGSDFileItem> fileItems, bool complete);
+    void PublishScanError(std::size_t generation, const wxString& error);
+
+    void CreateTaskList();
+    void ShowTasks();
+    void AppendRows();
+    void AppendTask(std::uint32_t itemId);
+    void AppendTasks(havGSDTaskIndex::ItemIds itemIds);
+    bool AppendGroup(const wxString& type, const wxString& filePath, std::size_t count);
+    havGSDTaskIndex::ItemIds GetGroupItemIds(const wxString& type, const wxString& filePath, const havGSDTaskIndex::ItemIds* filteredItemIds);
+    std::unordered_map<wxString, wxColour> GetTypeColours();
+    void UpdateSummary();
     void RefreshKeywordList();
+    void RescanFiles(const std::vector<wxString>& filePaths);
+    void WatchGitIndex(const wxString& directory);
+    void RescanGitIndexChanges();
+
+    // Written by the scan thread, read by the UI
+    havGSDSnapshotPublisher<havGSDScanResults> mScanResultsPublisher;
+
+    // Snapshot currently shown in the task list, only accessed by the UI
+    havGSDSnapshotPublisher<havGSDScanResults>::Snapshot mDisplayedScanResults;
+
+    // Rows of the task list, owned by mTaskListCtrl
+    havGSDTaskListModel* mTaskListModel;
+
+    // Keyword and file of the expanded groups, kept while the results change
+    std::unordered_set<wxString> mExpandedGroups;
+
+    havGSDScanScope mScanScope;
+    havGSDViewMode mViewMode;
+
+    // Columns the tasks are sorted by, the first one is the primary key, empty for scan order
+    std::vector<havGSDSortKey> mSortKeys;
+
+    std::thread mScanThread;
+    std::atomic<bool> mCancelScan;
+    std::atomic<bool> mScanRunning;
+    std::size_t mScanGeneration;
+
+    // Set by the scan thread once the helper couldn't be reached, later scans run inside CodeLite without waiting for it
+    // again until the settings are changed
+    std::atomic<bool> mScanDaemonUnavailable;
+
+    // Pauses background passes during builds and keeps them within the CPU budget otherwise
+    havGSDScanGovernor mScanGovernor;
+
+    // Last full scan, saved files of it are rescanned on their own
+    havGSDScanRequest mLastScanRequest;
+    std::unordered_set<wxString> mLastScanFilePaths;
+
+    // Polls the git index for checkouts, rebases and pulls, changed files of the project are kept while a scan is running
+    havGSDGitIndexWatcher mGitIndexWatcher;
+    std::unordered_set<wxString> mGitIndexChanges;
+
+    havGSDLatencyTracker mLatencyTracker;
 
-    std::vector<havGSDFileItem> mFileItems;
     clTabTogglerHelper::Ptr_t mTabToggler;
-    clThemedListCtrl* mThemedListCtrlForTasks;
+    wxDataViewCtrl* mTaskListCtrl;
+    wxTextCtrl* mFilterCtrl;
+    wxChoice* mScanScopeChoice;
+    wxChoice* mViewModeChoice;
+    wxStaticText* mSummaryText;
     wxPanel* mHavGSDPanel;
     wxString mWorkspaceType;
 
@@ -0,0 +1,433 @@
+/*
+havGSDBranchDelta.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDBRANCHDELTA_HPP
+#define HAVGSDBRANCHDELTA_HPP
+
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "havGSDGitIndex.hpp"
+#include "havGSDGitObjects.hpp"
+
+// Finds the lines of the project files which are new compared to a base ref, like a merge request would show them
+// - Files whose index entry matches the base and whose size and time match the index are skipped without reading them
+// - The other files are compared line by line with their version in the base, files missing there are new as a whole
+// - A base version which can't be read (too large, a damaged pack or a delta chain deeper than git writes) counts as missing,
+//   so its tasks show up as new rather than being hidden
+// - Files are streamed and only the hashes of their lines are kept, the work per file is bounded by MaxLineCount and MaxDiffSteps
+// - Opened once per scan request and reused by its rescans, it is used by one scan thread at a time
+class havGSDBranchDelta
+{
+public:
+    // Edit distance up to which the exact added lines are found, bigger changes count as added as a whole
+    static constexpr std::size_t MaxEditDistance = 1000;
+
+    // Steps of the line comparison per file, files needing more count as added as a whole
+    static constexpr std::size_t MaxDiffSteps = 16 * 1024 * 1024;
+
+    // Files or base versions with more lines aren't compared and count as added as a whole
+    static constexpr std::size_t MaxLineCount = 1024 * 1024;
+
+    // Reads the index and the tree of the base ref of the repository containing the directory, returns false once cancelled
+    bool Open(const wxString& directory, const wxString& baseRef, const std::atomic<bool>& cancel)
+    {
+        mOpen = false;
+        mIndexEntries.clear();
+        mBaseObjectIds.clear();
+
+        if (!mGitIndex.Open(directory) ||
+            !mGitIndex.Read(mIndexEntries, &cancel) ||
+            !mGitObjects.Open(mGitIndex.GetGitDirectory(), mGitIndex.GetHashSize()))
+        {
+            return false;
+        }
+
+        std::string treeId;
+        if (!mGitObjects.ResolveTree(baseRef, treeId))
+        {
+            return false;
+        }
+
+        // Same full paths as the index entries
+        const wxString separator = wxFileName::GetPathSeparator();
+        const wxString workTree = mGitIndex.GetWorkTree() + separator;
+
+        auto addObject = [&](const std::string& path, const std::string& objectId) {
+            wxString filePath = wxString::FromUTF8(path.data(), path.size());
+            if (separator != "/")
+            {
+                filePath.Replace("/", separator);
+            }
+
+            mBaseObjectIds.emplace(workTree + filePath, objectId);
+        };
+
+        mOpen = mGitObjects.ReadTree(treeId, std::string(), addObject, &cancel);
+        return mOpen;
+    }
+
+    bool IsOpen() const { return mOpen; }
+
+    // Returns true if the file has added lines, addedLines[line] is set for each added line (1-based)
+    // addedLines is left empty if the whole file counts as added, returns false once cancelled
+    bool GetAddedLines(const wxString& filePath, std::vector<bool>& addedLines, const std::atomic<bool>& cancel)
+    {
+        addedLines.clear();
+
+        auto baseObjectId = mBaseObjectIds.find(filePath);
+        auto indexEntry = mIndexEntries.find(filePath);
+
+        if (baseObjectId != mBaseObjectIds.end() && indexEntry != mIndexEntries.end() &&
+            baseObjectId->second == indexEntry->second.mObjectId && MatchesIndexEntry(filePath, indexEntry->second))
+        {
+            return false;
+        }
+
+        // A file which can't be read has no tasks to report
+        if (!HashFile(filePath, mLines, cancel))
+        {
+            return false;
+        }
+
+        if (mLines.size() > MaxLineCount)
+        {
+            return true;
+        }
+
+        mBaseLines.clear();
+
+        if (baseObjectId != mBaseObjectIds.end())
+        {
+            std::string baseContent;
+            if (mGitObjects.ReadBlob(baseObjectId->second, baseContent))
+            {
+                havGSDLineHasher lineHasher(mBaseLines);
+                lineHasher.Add(baseContent.data(), baseContent.size());
+                lineHasher.End();
+            }
+        }
+
+        if (mBaseLines.size() > MaxLineCount)
+        {
+            return !mLines.empty();
+        }
+
+        return DiffLines(mBaseLines, mLines, addedLines, cancel);
+    }
+
+private:
+    // Hashes the lines, split at '\n' like the scanner counts lines, a trailing '\r' is ignored for checkouts with CRLF
+    // Stops adding hashes once there are more than MaxLineCount lines
+    class havGSDLineHasher
+    {
+    public:
+        explicit havGSDLineHasher(std::vector<std::uint64_t>& lineHashes) : mLineHashes(lineHashes) { mLineHashes.clear(); }
+
+        void Add(const char* data, std::size_t size)
+        {
+            for (std::size_t index = 0; index < size && mLineHashes.size() <= MaxLineCount; ++index)
+            {
+                const char character = data[index];
+
+                if (character == '\n')
+                {
+                    EndLine();
+                    continue;
+                }
+
+                if (mCarriageReturn)
+                {
+                    Hash('\r');
+                    mCarriageReturn = false;
+                }
+
+                if (character == '\r')
+                {
+                    mCarriageReturn = true;
+                }
+                else
+                {
+                    Hash(character);
+                }
+
+                mLineStarted = true;
+            }
+        }
+
+        // The last line needs no '\n'
+        void End()
+        {
+            if (mLineStarted)
+            {
+                EndLine();
+            }
+        }
+
+    private:
+        // FNV-1a, a line is hashed while it is streamed
+        static constexpr std::uint64_t OffsetBasis = 14695981039346656037ULL;
+        static constexpr std::uint64_t Prime = 1099511628211ULL;
+
+        std::vector<std::uint64_t>& mLineHashes;
+        std::uint64_t mHash = OffsetBasis;
+        bool mLineStarted = false;
+        bool mCarriageReturn = false;
+
+        void Hash(char character)
+        {
+            mHash = (mHash ^ static_cast<unsigned char>(character)) * Prime;
+        }
+
+        void EndLine()
+        {
+            mLineHashes.push_back(mHash);
+            mHash = OffsetBasis;
+            mLineStarted = false;
+            mCarriageReturn = false;
+        }
+    };
+
+    static constexpr std::size_t ChunkSize = 64 * 1024;
+
+    havGSDGitIndex mGitIndex;
+    havGSDGitIndex::Fingerprints mIndexEntries;
+    havGSDGitObjects mGitObjects;
+    bool mOpen = false;
+
+    // Object ID of each file of the base ref by its full path
+    std::unordered_map<wxString, std::string> mBaseObjectIds;
+
+    // Line hashes of the file being compared, kept between files so they don't allocate again
+    std::vector<std::uint64_t> mLines;
+    std::vector<std::uint64_t> mBaseLines;
+    std::vector<char> mChunk;
+
+    // The size and time git stored when it last wrote the file to the index, like "git status" checks it
+    static bool MatchesIndexEntry(const wxString& filePath, const havGSDGitIndex::havGSDGitIndexEntry& indexEntry)
+    {
+        if (!wxFileExists(filePath))
+        {
+            return false;
+        }
+
+        const wxULongLong size = wxFileName::GetSize(filePath);
+        const time_t modificationTime = wxFileModificationTime(filePath);
+
+        return static_cast<uint32_t>(size.GetValue()) == indexEntry.mSize &&
+               static_cast<uint32_t>(modificationTime) == indexEntry.mModificationTime;
+    }
+
+    // Reads the file in chunks, only the hashes of its lines are kept
+    bool HashFile(const wxString& filePath, std::vector<std::uint64_t>& lineHashes, const std::atomic<bool>& cancel)
+    {
+        wxFile file;
+        if (!wxFileExists(filePath) || !file.Open(filePath))
+        {
+            return false;
+        }
+
+        havGSDLineHasher lineHasher(lineHashes);
+        mChunk.resize(ChunkSize);
+
+        while (lineHashes.size() <= MaxLineCount)
+        {
+            if (cancel)
+            {
+                return false;
+            }
+
+            const ssize_t chunkSize = file.Read(mChunk.data(), mChunk.size());
+            if (chunkSize < 0)
+            {
+                return false;
+            }
+
+            if (chunkSize == 0)
+            {
+                break;
+            }
+
+            lineHasher.Add(mChunk.data(), static_cast<std::size_t>(chunkSize));
+        }
+
+        lineHasher.End();
+        return true;
+    }
+
+    // Marks the lines missing in the base, returns true if any line was marked, changes which only delete lines mark none
+    static bool DiffLines(const std::vector<std::uint64_t>& baseLines, const std::vector<std::uint64_t>& lines, std::vector<bool>& addedLines,
+                          const std::atomic<bool>& cancel)
+    {
+        addedLines.assign(lines.size() + 2, false);
+
+        // Most changes are small, the common start and end are skipped before searching the shortest edit script
+        std::size_t prefixLength = 0;
+        while (prefixLength < baseLines.size() && prefixLength < lines.size() && baseLines[prefixLength] == lines[prefixLength])
+        {
+            ++prefixLength;
+        }
+
+        std::size_t suffixLength = 0;
+        while (suffixLength < baseLines.size() - prefixLength && suffixLength < lines.size() - prefixLength &&
+               baseLines[baseLines.size() - 1 - suffixLength] == lines[lines.size() - 1 - suffixLength])
+        {
+            ++suffixLength;
+        }
+
+        const std::uint64_t* const a = baseLines.data() + prefixLength;
+        const std::uint64_t* const b = lines.data() + prefixLength;
+        const long n = static_cast<long>(baseLines.size() - prefixLength - suffixLength);
+        const long m = static_cast<long>(lines.size() - prefixLength - suffixLength);
+
+        if (m == 0)
+        {
+            return false;
+        }
+
+        // Line numbers start at 1
+        auto markAdded = [&](long line) { addedLines[prefixLength + static_cast<std::size_t>(line) + 1] = true; };
+
+        if (n == 0)
+        {
+            for (long line = 0; line < m; ++line)
+            {
+                markAdded(line);
+            }
+
+            return true;
+        }
+
+        // Myers' algorithm, the furthest x per diagonal k = x - y is kept for each edit distance d to trace the script back
+        const long maxDistance = std::min<long>(n + m, static_cast<long>(MaxEditDistance));
+        std::vector<long> furthest(2 * static_cast<std::size_t>(maxDistance) + 3, 0);
+        std::vector<std::vector<long>> trace;
+
+        auto at = [&](std::vector<long>& values, long k) -> long& { return values[static_cast<std::size_t>(k + maxDistance + 1)]; };
+
+        long distance = -1;
+        std::size_t steps = 0;
+
+        for (long d = 0; d <= maxDistance && distance < 0 && steps <= MaxDiffSteps; ++d)
+        {
+            if (cancel)
+            {
+                return false;
+            }
+
+            for (long k = -d; k <= d; k += 2)
+            {
+                long x = (k == -d || (k != d && at(furthest, k - 1) < at(furthest, k + 1))) ? at(furthest, k + 1) : at(furthest, k - 1) + 1;
+                long y = x - k;
+
+                ++steps;
+
+                while (x < n && y < m && a[x] == b[y])
+                {
+                    ++x;
+                    ++y;
+                    ++steps;
+                }
+
+                at(furthest, k) = x;
+
+                if (x >= n && y >= m)
+                {
+                    distance = d;
+                    break;
+                }
+            }
+
+            // Only the diagonals -d..d are needed later
+            trace.emplace_back(furthest.begin() + (maxDistance + 1 - d), furthest.begin() + (maxDistance + 1 + d + 1));
+        }
+
+        if (distance < 0)
+        {
+            for (long line = 0; line < m; ++line)
+            {
+                markAdded(line);
+            }
+
+            return true;
+        }
+
+        long x = n;
+        long y = m;
+        bool marked = false;
+
+        for (long d = distance; d > 0; --d)
+        {
+            const std::vector<long>& previous = trace[static_cast<std::size_t>(d - 1)];
+            auto previousAt = [&](long k) { return previous[static_cast<std::size_t>(k + d - 1)]; };
+
+            const long k = x - y;
+            const bool down = (k == -d || (k != d && previousAt(k - 1) < previousAt(k + 1)));
+            const long previousK = down ? k + 1 : k - 1;
+            const long previousX = previousAt(previousK);
+            const long previousY = previousX - previousK;
+
+            // A step down inserts line previousY of the content, a step right deletes a line of the base
+            if (down)
+            {
+                markAdded(previousY);
+                marked = true;
+            }
+
+            x = previousX;
+            y = previousY;
+        }
+
+        return marked;
+    }
+};
+
+#endif
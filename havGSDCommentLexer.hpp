@@ -0,0 +1,333 @@
+/*
+havGSDCommentLexer.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDCOMMENTLEXER_HPP
+#define HAVGSDCOMMENTLEXER_HPP
+
+#include <wx/filename.h>
+#include <wx/string.h>
+#include <wx/tokenzr.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Comment tokens of a language, only ASCII tokens are supported
+struct havGSDCommentSyntax
+{
+    std::vector<std::string> mLineComments;
+    std::vector<std::pair<std::string, std::string>> mBlockComments;
+};
+
+// DFA compiled from a comment syntax, the scanner feeds it one character at a time
+// - The code states form a trie of the comment openers with failure transitions, like Aho-Corasick
+// - A completed opener which is the prefix of a longer one (-- and --[[ in Lua) is decided once the longer one can't match anymore
+// - Each block comment has one state per matched character of its closer, like KMP
+class havGSDCommentLexer
+{
+public:
+    using State = std::uint16_t;
+
+    static constexpr State CodeState = 0;
+
+    explicit havGSDCommentLexer(const havGSDCommentSyntax& syntax) { Compile(syntax); }
+
+    State Next(State state, wxChar character) const
+    {
+        const std::uint32_t characterClass = static_cast<std::uint32_t>(character) < OtherCharacters ? static_cast<std::uint32_t>(character) : OtherCharacters;
+        return mTransitions[state * CharacterClassCount + characterClass];
+    }
+
+    bool IsComment(State state) const { return mIsComment[state] != 0; }
+
+    // The rest of the line is a comment
+    bool IsLineComment(State state) const { return state == mLineCommentState; }
+
+    // Line comments end with the line, block comments continue on the next line
+    State EndLine(State state) const { return mEndOfLine[state]; }
+
+private:
+    // ASCII characters have their own column in the transition table, everything else shares the last one
+    static constexpr std::uint32_t OtherCharacters = 128;
+    static constexpr std::uint32_t CharacterClassCount = OtherCharacters + 1;
+
+    struct havGSDTrieNode
+    {
+        std::map<char, State> mChildren;
+        State mFailure = CodeState;
+        int mOpener = -1; // Opener completed on the way here, its own or the one of an ancestor or the failure node
+    };
+
+    void Compile(const havGSDCommentSyntax& syntax)
+    {
+        // Openers and the state they lead to, the line comment state follows the trie nodes
+        std::vector<std::pair<std::string, std::size_t>> openers;
+
+        for (const auto& lineComment : syntax.mLineComments)
+        {
+            openers.emplace_back(lineComment, 0);
+        }
+
+        for (std::size_t blockIndex = 0; blockIndex < syntax.mBlockComments.size(); ++blockIndex)
+        {
+            openers.emplace_back(syntax.mBlockComments[blockIndex].first, blockIndex + 1);
+        }
+
+        std::vector<havGSDTrieNode> trie(1);
+
+        for (std::size_t openerIndex = 0; openerIndex < openers.size(); ++openerIndex)
+        {
+            State node = CodeState;
+
+            for (char character : openers[openerIndex].first)
+            {
+                auto foundChild = trie[node].mChildren.find(character);
+                if (foundChild != trie[node].mChildren.end())
+                {
+                    node = foundChild->second;
+                    continue;
+                }
+
+                const State child = static_cast<State>(trie.size());
+                trie[node].mChildren.emplace(character, child);
+                trie.emplace_back();
+
+                node = child;
+            }
+
+            trie[node].mOpener = static_cast<int>(openerIndex);
+        }
+
+        // Failure links in breadth-first order, so the failure node of a node is always done before it
+        std::vector<State> order(1, CodeState);
+
+        for (std::size_t orderIndex = 0; orderIndex < order.size(); ++orderIndex)
+        {
+            const State node = order[orderIndex];
+
+            for (const auto& [character, child] : trie[node].mChildren)
+            {
+                if (node != CodeState)
+                {
+                    State failure = trie[node].mFailure;
+
+                    while (failure != CodeState && trie[failure].mChildren.count(character) == 0)
+                    {
+                        failure = trie[failure].mFailure;
+                    }
+
+                    auto foundChild = trie[failure].mChildren.find(character);
+                    trie[child].mFailure = (foundChild != trie[failure].mChildren.end()) ? foundChild->second : CodeState;
+                }
+
+                // An opener which started earlier wins over one which ends here as a suffix
+                if (trie[child].mOpener < 0)
+                {
+                    trie[child].mOpener = (trie[node].mOpener >= 0) ? trie[node].mOpener : trie[trie[child].mFailure].mOpener;
+                }
+
+                order.push_back(child);
+            }
+        }
+
+        // Comment states
+        mLineCommentState = static_cast<State>(trie.size());
+
+        std::vector<State> blockStates;
+        State stateCount = mLineCommentState + 1;
+
+        for (const auto& blockComment : syntax.mBlockComments)
+        {
+            blockStates.push_back(stateCount);
+            stateCount += static_cast<State>(blockComment.second.length());
+        }
+
+        mTransitions.assign(static_cast<std::size_t>(stateCount) * CharacterClassCount, CodeState);
+        mIsComment.assign(stateCount, 1);
+        mEndOfLine.assign(stateCount, CodeState);
+
+        auto transition = [this](State state, std::uint32_t characterClass) -> State& {
+            return mTransitions[state * CharacterClassCount + characterClass];
+        };
+
+        for (std::uint32_t characterClass = 0; characterClass < CharacterClassCount; ++characterClass)
+        {
+            transition(mLineCommentState, characterClass) = mLineCommentState;
+        }
+
+        for (std::size_t blockIndex = 0; blockIndex < syntax.mBlockComments.size(); ++blockIndex)
+        {
+            const std::string& closer = syntax.mBlockComments[blockIndex].second;
+            const State firstState = blockStates[blockIndex];
+
+            // State firstState + matched is reached after the first matched characters of the closer
+            State fallback = 0;
+
+            for (State matched = 0; matched < closer.length(); ++matched)
+            {
+                const State state = firstState + matched;
+
+                for (std::uint32_t characterClass = 0; characterClass < CharacterClassCount; ++characterClass)
+                {
+                    if (characterClass == static_cast<unsigned char>(closer[matched]))
+                    {
+                        transition(state, characterClass) = (matched + 1u == closer.length()) ? CodeState : static_cast<State>(state + 1);
+                    }
+                    else
+                    {
+                        transition(state, characterClass) = (matched == 0) ? firstState : transition(firstState + fallback, characterClass);
+                    }
+                }
+
+                if (matched > 0)
+                {
+                    const State next = transition(firstState + fallback, static_cast<unsigned char>(closer[matched]));
+                    fallback = (next == CodeState) ? 0 : static_cast<State>(next - firstState);
+                }
+
+                // Closers don't span lines
+                mEndOfLine[state] = firstState;
+            }
+        }
+
+        auto openerState = [&](int opener) -> State {
+            const std::size_t target = openers[opener].second;
+            return (target == 0) ? mLineCommentState : blockStates[target - 1];
+        };
+
+        for (State node : order)
+        {
+            const havGSDTrieNode& trieNode = trie[node];
+
+            mIsComment[node] = (trieNode.mOpener >= 0) ? 1 : 0;
+
+            if (trieNode.mOpener >= 0 && openerState(trieNode.mOpener) != mLineCommentState)
+            {
+                mEndOfLine[node] = openerState(trieNode.mOpener);
+            }
+
+            for (std::uint32_t characterClass = 0; characterClass < CharacterClassCount; ++characterClass)
+            {
+                auto foundChild = (characterClass < OtherCharacters) ? trieNode.mChildren.find(static_cast<char>(characterClass)) : trieNode.mChildren.end();
+
+                if (foundChild != trieNode.mChildren.end())
+                {
+                    transition(node, characterClass) = foundChild->second;
+                }
+                else if (trieNode.mOpener >= 0)
+                {
+                    // The opener is complete, the character is the first one of the comment
+                    transition(node, characterClass) = transition(openerState(trieNode.mOpener), characterClass);
+                }
+                else if (node != CodeState)
+                {
+                    transition(node, characterClass) = transition(trieNode.mFailure, characterClass);
+                }
+            }
+        }
+    }
+
+    std::vector<State> mTransitions;
+    std::vector<std::uint8_t> mIsComment;
+    std::vector<State> mEndOfLine;
+    State mLineCommentState = 0;
+};
+
+// Comment syntax of the files in a project, chosen by file name or extension
+class havGSDLanguageTable
+{
+public:
+    static const havGSDLanguageTable& Get()
+    {
+        static const havGSDLanguageTable languageTable;
+        return languageTable;
+    }
+
+    // Files of unknown languages are scanned for C++ comments
+    const havGSDCommentLexer& Find(const wxFileName& file) const
+    {
+        auto foundLanguage = mLanguages.find(file.GetFullName().Lower());
+
+        if (foundLanguage == mLanguages.end())
+        {
+            foundLanguage = mLanguages.find("*." + file.GetExt().Lower());
+        }
+
+        return (foundLanguage != mLanguages.end()) ? mLexers[foundLanguage->second] : mLexers.front();
+    }
+
+private:
+    havGSDLanguageTable()
+    {
+        // Lowercase file names and extensions, the first language is the default
+        AddLanguage({ { "//" }, { { "/*", "*/" } } },
+                    "*.c *.cc *.cpp *.cxx *.c++ *.h *.hh *.hpp *.hxx *.h++ *.inl *.ipp *.tpp *.m *.mm "
+                    "*.cs *.java *.js *.ts *.go *.rs *.swift *.kt *.glsl *.hlsl *.vert *.frag *.proto");
+        AddLanguage({ { "#" }, {} },
+                    "cmakelists.txt *.cmake makefile gnumakefile *.mk *.mak dockerfile "
+                    "*.py *.pyw *.sh *.bash *.zsh *.yaml *.yml *.toml *.rb *.pl *.pm *.r");
+        AddLanguage({ { "#" }, { { "<#", "#>" } } }, "*.ps1 *.psm1");
+        AddLanguage({ { ";", "#" }, {} }, "*.ini *.cfg *.conf");
+        AddLanguage({ { "--" }, { { "--[[", "]]" } } }, "*.lua");
+        AddLanguage({ { "--" }, { { "/*", "*/" } } }, "*.sql");
+        AddLanguage({ {}, { { "/*", "*/" } } }, "*.css");
+        AddLanguage({ {}, { { "<!--", "-->" } } }, "*.xml *.xrc *.html *.htm *.svg");
+    }
+
+    void AddLanguage(const havGSDCommentSyntax& syntax, const wxString& patterns)
+    {
+        wxStringTokenizer tokenizer(patterns, " ", wxTOKEN_STRTOK);
+        while (tokenizer.HasMoreTokens())
+        {
+            mLanguages.emplace(tokenizer.GetNextToken(), mLexers.size());
+        }
+
+        mLexers.emplace_back(syntax);
+    }
+
+    std::vector<havGSDCommentLexer> mLexers;
+    std::unordered_map<wxString, std::size_t> mLanguages;
+};
+
+#endif
@@ -0,0 +1,398 @@
+/*
+havGSDGitIndex.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDGITINDEX_HPP
+#define HAVGSDGITINDEX_HPP
+
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Reads the index file of a local git repository directly, without running git
+// - The object ID of each tracked file tells, whether checkouts, rebases or pulls changed its content
+// - Supports the index versions 2, 3 and 4 and repositories using SHA-1 or SHA-256 object IDs
+class havGSDGitIndex
+{
+public:
+    struct havGSDGitIndexEntry
+    {
+        std::string mObjectId;
+
+        // Lower 32 bits of the modification time (seconds) and of the size, as git stored them
+        uint32_t mModificationTime = 0;
+        uint32_t mSize = 0;
+    };
+
+    // Entry of each tracked file by its full path
+    using Fingerprints = std::unordered_map<wxString, havGSDGitIndexEntry>;
+
+    // Finds the repository containing the directory, returns false if there is none
+    bool Open(const wxString& directory)
+    {
+        mWorkTree.clear();
+        mGitDirectory.clear();
+        mIndexPath.clear();
+        mHashSize = Sha1Size;
+
+        wxFileName workTree = wxFileName::DirName(directory);
+        wxString gitDirectory;
+
+        while (true)
+        {
+            const wxString dotGit = wxFileName(workTree.GetPath(), ".git").GetFullPath();
+
+            if (wxDirExists(dotGit))
+            {
+                gitDirectory = dotGit;
+                break;
+            }
+
+            // Worktrees and submodules refer to their git directory: "gitdir: <path>"
+            if (wxFileExists(dotGit))
+            {
+                std::vector<unsigned char> data;
+                if (!ReadFile(dotGit, data))
+                {
+                    return false;
+                }
+
+                wxString content = wxString::FromUTF8(reinterpret_cast<const char*>(data.data()), data.size());
+                if (!content.StartsWith("gitdir:", &gitDirectory))
+                {
+                    return false;
+                }
+
+                gitDirectory.Trim(false).Trim(true);
+
+                wxFileName gitDirectoryName = wxFileName::DirName(gitDirectory);
+                gitDirectoryName.MakeAbsolute(workTree.GetPath());
+                gitDirectory = gitDirectoryName.GetPath();
+                break;
+            }
+
+            if (workTree.GetDirCount() == 0)
+            {
+                return false;
+            }
+
+            workTree.RemoveLastDir();
+        }
+
+        mWorkTree = workTree.GetPath();
+        mGitDirectory = gitDirectory;
+        mIndexPath = wxFileName(gitDirectory, "index").GetFullPath();
+
+        // Linked worktrees share the configuration of the main git directory, which "commondir" refers to
+        wxString commonDirectory = gitDirectory;
+
+        std::vector<unsigned char> commonDirectoryData;
+        if (ReadFile(wxFileName(gitDirectory, "commondir").GetFullPath(), commonDirectoryData))
+        {
+            wxString content = wxString::FromUTF8(reinterpret_cast<const char*>(commonDirectoryData.data()), commonDirectoryData.size());
+            wxFileName commonDirectoryName = wxFileName::DirName(content.Trim(true).Trim(false));
+            commonDirectoryName.MakeAbsolute(gitDirectory);
+            commonDirectory = commonDirectoryName.GetPath();
+        }
+
+        // SHA-256 repositories are marked in the configuration: "objectFormat = sha256", the key ignores case
+        std::vector<unsigned char> config;
+        if (ReadFile(wxFileName(commonDirectory, "config").GetFullPath(), config))
+        {
+            std::string configText;
+            for (unsigned char character : config)
+            {
+                if (character != ' ' && character != '\t')
+                {
+                    configText += static_cast<char>(std::tolower(character));
+                }
+            }
+
+            if (configText.find("objectformat=sha256") != std::string::npos)
+            {
+                mHashSize = Sha256Size;
+            }
+        }
+
+        return true;
+    }
+
+    bool IsOpen() const { return !mIndexPath.IsEmpty(); }
+
+    const wxString& GetWorkTree() const { return mWorkTree; }
+    const wxString& GetGitDirectory() const { return mGitDirectory; }
+    std::size_t GetHashSize() const { return mHashSize; }
+
+    // Reads the checksum at the end of the index, which changes whenever git writes the index
+    bool ReadChecksum(std::string& checksum) const
+    {
+        wxFile file;
+        if (!IsOpen() || !wxFileExists(mIndexPath) || !file.Open(mIndexPath))
+        {
+            return false;
+        }
+
+        checksum.assign(mHashSize, '\0');
+
+        return file.Length() >= static_cast<wxFileOffset>(HeaderSize + mHashSize) &&
+               file.Seek(-static_cast<wxFileOffset>(mHashSize), wxFromEnd) != wxInvalidOffset &&
+               file.Read(&checksum[0], mHashSize) == static_cast<ssize_t>(mHashSize);
+    }
+
+    // Reads the object IDs of all tracked files, returns false if the index can't be read or parsed or once cancelled
+    bool Read(Fingerprints& fingerprints, const std::atomic<bool>* cancel = nullptr) const
+    {
+        fingerprints.clear();
+
+        std::vector<unsigned char> data;
+        if (!IsOpen() || !ReadFile(mIndexPath, data) || data.size() < HeaderSize + mHashSize ||
+            std::memcmp(data.data(), "DIRC", 4) != 0)
+        {
+            return false;
+        }
+
+        const unsigned char* const begin = data.data();
+        const unsigned char* const end = begin + data.size() - mHashSize;
+
+        const uint32_t version = ReadUInt32(begin + 4);
+        const uint32_t entryCount = ReadUInt32(begin + 8);
+
+        if (version < 2 || version > 4)
+        {
+            return false;
+        }
+
+        // ctime, mtime, dev, ino, mode, uid, gid and size precede the object ID, the flags follow it
+        const std::size_t statSize = 40;
+        const std::size_t fixedSize = statSize + mHashSize + 2;
+
+        const wxString separator = wxFileName::GetPathSeparator();
+        const wxString workTree = mWorkTree + separator;
+
+        fingerprints.reserve(entryCount);
+
+        const unsigned char* position = begin + HeaderSize;
+        std::string path;
+
+        for (uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex)
+        {
+            if (cancel && *cancel)
+            {
+                return false;
+            }
+
+            const unsigned char* const entry = position;
+
+            if (static_cast<std::size_t>(end - position) < fixedSize)
+            {
+                return false;
+            }
+
+            const uint16_t flags = ReadUInt16(entry + statSize + mHashSize);
+            position += fixedSize;
+
+            // Extended flags (version 3 and later)
+            if (flags & 0x4000)
+            {
+                if (version < 3 || end - position < 2)
+                {
+                    return false;
+                }
+
+                position += 2;
+            }
+
+            // Version 4 strips a number of bytes from the end of the previous path and appends the rest
+            if (version == 4)
+            {
+                std::size_t stripLength = 0;
+                if (!ReadOffset(position, end, stripLength) || stripLength > path.size())
+                {
+                    return false;
+                }
+
+                path.erase(path.size() - stripLength);
+            }
+            else
+            {
+                path.clear();
+            }
+
+            const unsigned char* const pathEnd = static_cast<const unsigned char*>(std::memchr(position, 0, end - position));
+            if (!pathEnd)
+            {
+                return false;
+            }
+
+            path.append(reinterpret_cast<const char*>(position), pathEnd - position);
+            position = pathEnd + 1;
+
+            // Entries before version 4 are padded with NULs to a multiple of 8 bytes
+            if (version < 4)
+            {
+                const std::size_t entrySize = (pathEnd - entry + 8) & ~static_cast<std::size_t>(7);
+                if (entrySize > static_cast<std::size_t>(end - entry))
+                {
+                    return false;
+                }
+
+                position = entry + entrySize;
+            }
+
+            // Skip the stages of merge conflicts
+            if ((flags & 0x3000) != 0)
+            {
+                continue;
+            }
+
+            wxString filePath = wxString::FromUTF8(path.data(), path.size());
+            if (separator != "/")
+            {
+                filePath.Replace("/", separator);
+            }
+
+            havGSDGitIndexEntry& indexEntry = fingerprints[workTree + filePath];
+            indexEntry.mObjectId.assign(reinterpret_cast<const char*>(entry + statSize), mHashSize);
+            indexEntry.mModificationTime = ReadUInt32(entry + 8);
+            indexEntry.mSize = ReadUInt32(entry + 36);
+        }
+
+        return true;
+    }
+
+    // Calls the function for each file whose object ID changed, was added or was removed
+    template <typename Function>
+    static void Compare(const Fingerprints& oldFingerprints, const Fingerprints& newFingerprints, Function function)
+    {
+        for (const auto& [filePath, indexEntry] : newFingerprints)
+        {
+            auto oldFingerprint = oldFingerprints.find(filePath);
+            if (oldFingerprint == oldFingerprints.end() || oldFingerprint->second.mObjectId != indexEntry.mObjectId)
+            {
+                function(filePath);
+            }
+        }
+
+        for (const auto& oldFingerprint : oldFingerprints)
+        {
+            if (newFingerprints.count(oldFingerprint.first) == 0)
+            {
+                function(oldFingerprint.first);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t HeaderSize = 12;
+    static constexpr std::size_t Sha1Size = 20;
+    static constexpr std::size_t Sha256Size = 32;
+
+    wxString mWorkTree;
+    wxString mGitDirectory;
+    wxString mIndexPath;
+    std::size_t mHashSize = Sha1Size;
+
+    static bool ReadFile(const wxString& filePath, std::vector<unsigned char>& data)
+    {
+        wxFile file;
+        if (!wxFileExists(filePath) || !file.Open(filePath))
+        {
+            return false;
+        }
+
+        const wxFileOffset length = file.Length();
+        if (length < 0)
+        {
+            return false;
+        }
+
+        data.resize(static_cast<std::size_t>(length));
+
+        return data.empty() || file.Read(data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    }
+
+    static uint32_t ReadUInt32(const unsigned char* data)
+    {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+    }
+
+    static uint16_t ReadUInt16(const unsigned char* data)
+    {
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+
+    // Variable-length offset encoding of git, each continuation adds one before shifting
+    static bool ReadOffset(const unsigned char*& position, const unsigned char* end, std::size_t& value)
+    {
+        if (position == end)
+        {
+            return false;
+        }
+
+        unsigned char byte = *position++;
+        value = byte & 0x7F;
+
+        while (byte & 0x80)
+        {
+            if (position == end || value > (SIZE_MAX >> 8))
+            {
+                return false;
+            }
+
+            byte = *position++;
+            value = ((value + 1) << 7) | (byte & 0x7F);
+        }
+
+        return true;
+    }
+};
+
+#endif
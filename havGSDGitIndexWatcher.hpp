@@ -0,0 +1,165 @@
+/*
+havGSDGitIndexWatcher.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDGITINDEXWATCHER_HPP
+#define HAVGSDGITINDEXWATCHER_HPP
+
+#include <wx/string.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "havGSDGitIndex.hpp"
+
+// Polls the git index of a repository on its own thread, so reading and comparing a large index never blocks the UI
+// - Only the checksum at the end of the index is read, until git writes the index again
+// - The changed files are passed to a function called on the watcher thread
+class havGSDGitIndexWatcher
+{
+public:
+    using ChangedFunction = std::function<void(std::vector<wxString> filePaths)>;
+
+    static constexpr std::chrono::milliseconds PollInterval{ 2000 };
+
+    ~havGSDGitIndexWatcher() { Stop(); }
+
+    // Called by the UI, watches the repository containing the directory until stopped
+    void Start(const wxString& directory, ChangedFunction changed)
+    {
+        Stop();
+
+        mStopping = false;
+        mThread = std::thread(
+            [this, directory = wxString(directory.wc_str()), changed = std::move(changed)]() {
+                // An uncaught exception would terminate CodeLite, watching just ends
+                try
+                {
+                    Run(directory, changed);
+                }
+                catch (const std::exception&)
+                {
+                }
+            });
+    }
+
+    // Called by the UI, an index read in progress stops between its entries
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+
+        mCondition.notify_all();
+
+        if (mThread.joinable())
+        {
+            mThread.join();
+        }
+    }
+
+private:
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::atomic<bool> mStopping{ false }; // Set under the mutex, read without it while the index is read
+
+    // Runs on the watcher thread
+    void Run(const wxString& directory, const ChangedFunction& changed)
+    {
+        // The first fingerprints are taken while the scan reads the files, a checkout in between is only noticed by the next scan
+        havGSDGitIndex gitIndex;
+        havGSDGitIndex::Fingerprints fingerprints;
+        std::string checksum;
+
+        if (!gitIndex.Open(directory) ||
+            !gitIndex.ReadChecksum(checksum) ||
+            !gitIndex.Read(fingerprints, &mStopping))
+        {
+            return;
+        }
+
+        while (Wait())
+        {
+            std::string newChecksum;
+            if (!gitIndex.ReadChecksum(newChecksum) || newChecksum == checksum)
+            {
+                continue;
+            }
+
+            havGSDGitIndex::Fingerprints newFingerprints;
+            if (!gitIndex.Read(newFingerprints, &mStopping))
+            {
+                continue;
+            }
+
+            std::vector<wxString> filePaths;
+
+            havGSDGitIndex::Compare(fingerprints, newFingerprints, [&](const wxString& filePath) {
+                filePaths.push_back(filePath);
+            });
+
+            fingerprints.swap(newFingerprints);
+            checksum = newChecksum;
+
+            if (!filePaths.empty())
+            {
+                changed(std::move(filePaths));
+            }
+        }
+    }
+
+    // Returns false once stopped
+    bool Wait()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        return !mCondition.wait_for(lock, PollInterval, [this]() { return mStopping.load(); });
+    }
+};
+
+#endif
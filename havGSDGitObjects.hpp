@@ -0,0 +1,924 @@
+/*
+havGSDGitObjects.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDGITOBJECTS_HPP
+#define HAVGSDGITOBJECTS_HPP
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/string.h>
+#include <wx/wfstream.h>
+#include <wx/zstream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Reads commits, trees and blobs from the object database of a local git repository, without running git
+// - Loose objects and pack files (index version 2) including both kinds of deltas
+// - Refs are resolved like git does for branch, tag and remote names, or given as full object IDs
+// - Sizes come from the repository and are checked before anything is allocated, so a corrupted object can't exhaust the memory
+class havGSDGitObjects
+{
+public:
+    // Larger objects (and deltas producing them) aren't read, ReadObject() fails for them
+    static constexpr std::size_t MaxObjectSize = 64 * 1024 * 1024;
+
+    enum class havGSDObjectType
+    {
+        None = 0,
+        Commit = 1,
+        Tree = 2,
+        Blob = 3,
+        Tag = 4
+    };
+
+    bool Open(const wxString& gitDirectory, std::size_t hashSize)
+    {
+        mGitDirectory = gitDirectory;
+        mHashSize = hashSize;
+        mPacks.clear();
+        mPackedRefs.clear();
+        mCache.clear();
+        mCacheSize = 0;
+
+        // Worktrees share the objects and refs of the main repository
+        mCommonDirectory = gitDirectory;
+
+        std::string commonDirectory;
+        if (ReadFile(wxFileName(gitDirectory, "commondir").GetFullPath(), commonDirectory))
+        {
+            wxFileName commonDirectoryName = wxFileName::DirName(wxString::FromUTF8(commonDirectory.data(), commonDirectory.size()).Trim(true).Trim(false));
+            commonDirectoryName.MakeAbsolute(gitDirectory);
+            mCommonDirectory = commonDirectoryName.GetPath();
+        }
+
+        mObjectsDirectory = wxFileName(mCommonDirectory, "objects").GetFullPath();
+
+        if (!wxDirExists(mObjectsDirectory))
+        {
+            return false;
+        }
+
+        ReadPackedRefs();
+        OpenPacks();
+
+        return true;
+    }
+
+    // Returns the tree of the commit the ref points to, tags are followed
+    bool ResolveTree(const wxString& ref, std::string& treeId)
+    {
+        std::string objectId;
+        if (!ResolveRef(ref, objectId))
+        {
+            return false;
+        }
+
+        for (int depth = 0; depth < MaxRefDepth; ++depth)
+        {
+            havGSDObjectType type = havGSDObjectType::None;
+            std::string data;
+
+            if (!ReadObject(objectId, type, data))
+            {
+                return false;
+            }
+
+            switch (type)
+            {
+            case havGSDObjectType::Tag:
+                if (!ReadHeaderId(data, "object ", objectId))
+                {
+                    return false;
+                }
+                break;
+            case havGSDObjectType::Commit:
+                return ReadHeaderId(data, "tree ", treeId);
+            case havGSDObjectType::Tree:
+                treeId = objectId;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    // Calls the function with the path ("dir/file", UTF-8) and the object ID of each file in the tree, submodules are skipped
+    // Returns false if a tree can't be read or once cancelled
+    template <typename Function>
+    bool ReadTree(const std::string& treeId, const std::string& prefix, Function& function, const std::atomic<bool>* cancel = nullptr)
+    {
+        havGSDObjectType type = havGSDObjectType::None;
+        std::string data;
+
+        if (!ReadObject(treeId, type, data) || type != havGSDObjectType::Tree)
+        {
+            return false;
+        }
+
+        // Entries: "<mode> <name>\0<object ID>"
+        std::size_t position = 0;
+
+        while (position < data.size())
+        {
+            if (cancel && *cancel)
+            {
+                return false;
+            }
+
+            const std::size_t nameStart = data.find(' ', position);
+            const std::size_t nameEnd = (nameStart == std::string::npos) ? std::string::npos : data.find('\0', nameStart);
+
+            if (nameEnd == std::string::npos || nameEnd + 1 + mHashSize > data.size())
+            {
+                return false;
+            }
+
+            const std::string mode = data.substr(position, nameStart - position);
+            const std::string path = prefix + data.substr(nameStart + 1, nameEnd - nameStart - 1);
+            const std::string objectId = data.substr(nameEnd + 1, mHashSize);
+
+            position = nameEnd + 1 + mHashSize;
+
+            if (mode == "40000")
+            {
+                if (!ReadTree(objectId, path + "/", function, cancel))
+                {
+                    return false;
+                }
+            }
+            else if (mode != "160000")
+            {
+                function(path, objectId);
+            }
+        }
+
+        return true;
+    }
+
+    bool ReadBlob(const std::string& objectId, std::string& data)
+    {
+        havGSDObjectType type = havGSDObjectType::None;
+        return ReadObject(objectId, type, data) && type == havGSDObjectType::Blob;
+    }
+
+    bool ReadObject(const std::string& objectId, havGSDObjectType& type, std::string& data)
+    {
+        return ReadObject(objectId, type, data, 0);
+    }
+
+private:
+    static constexpr int MaxRefDepth = 8;
+    static constexpr int MaxDeltaDepth = 64;
+
+    // Bases of deltas are read again and again, the cache is emptied when it gets larger than this
+    static constexpr std::size_t MaxCacheSize = 32 * 1024 * 1024;
+
+    // Object types in pack files
+    static constexpr int OffsetDelta = 6;
+    static constexpr int RefDelta = 7;
+
+    struct havGSDPack
+    {
+        wxFile mIndexFile;
+        std::unique_ptr<wxFileInputStream> mPackStream;
+        uint32_t mFanout[256] = {};
+    };
+
+    struct havGSDCachedObject
+    {
+        havGSDObjectType mType;
+        std::string mData;
+    };
+
+    wxString mGitDirectory;
+    wxString mCommonDirectory;
+    wxString mObjectsDirectory;
+    std::size_t mHashSize = 20;
+
+    std::vector<std::unique_ptr<havGSDPack>> mPacks;
+    std::unordered_map<std::string, std::string> mPackedRefs;
+
+    // Keyed by pack and offset
+    std::map<std::pair<std::size_t, uint64_t>, havGSDCachedObject> mCache;
+    std::size_t mCacheSize = 0;
+
+    static bool ReadFile(const wxString& filePath, std::string& data)
+    {
+        wxFile file;
+        if (!wxFileExists(filePath) || !file.Open(filePath))
+        {
+            return false;
+        }
+
+        const wxFileOffset length = file.Length();
+        if (length < 0)
+        {
+            return false;
+        }
+
+        data.resize(static_cast<std::size_t>(length));
+
+        return data.empty() || file.Read(&data[0], data.size()) == static_cast<ssize_t>(data.size());
+    }
+
+    static int HexDigit(char character)
+    {
+        if (character >= '0' && character <= '9')
+        {
+            return character - '0';
+        }
+
+        if (character >= 'a' && character <= 'f')
+        {
+            return character - 'a' + 10;
+        }
+
+        return -1;
+    }
+
+    bool FromHex(const std::string& hex, std::string& objectId) const
+    {
+        if (hex.size() != mHashSize * 2)
+        {
+            return false;
+        }
+
+        objectId.assign(mHashSize, '\0');
+
+        for (std::size_t index = 0; index < mHashSize; ++index)
+        {
+            const int high = HexDigit(hex[index * 2]);
+            const int low = HexDigit(hex[index * 2 + 1]);
+
+            if (high < 0 || low < 0)
+            {
+                return false;
+            }
+
+            objectId[index] = static_cast<char>((high << 4) | low);
+        }
+
+        return true;
+    }
+
+    static std::string ToHex(const std::string& objectId)
+    {
+        static const char digits[] = "0123456789abcdef";
+
+        std::string hex;
+        hex.reserve(objectId.size() * 2);
+
+        for (const char character : objectId)
+        {
+            hex += digits[(static_cast<unsigned char>(character) >> 4) & 0x0F];
+            hex += digits[static_cast<unsigned char>(character) & 0x0F];
+        }
+
+        return hex;
+    }
+
+    // Reads the object ID of a header line of a commit or tag, like "tree <hex>"
+    bool ReadHeaderId(const std::string& data, const std::string& header, std::string& objectId) const
+    {
+        std::size_t position = 0;
+
+        while (position < data.size() && data[position] != '\n')
+        {
+            const std::size_t lineEnd = std::min(data.find('\n', position), data.size());
+
+            if (data.compare(position, header.size(), header) == 0)
+            {
+                return FromHex(data.substr(position + header.size(), lineEnd - position - header.size()), objectId);
+            }
+
+            position = lineEnd + 1;
+        }
+
+        return false;
+    }
+
+    // "<hex> <ref name>" per line, "^<hex>" lines carry the peeled object of the tag before
+    void ReadPackedRefs()
+    {
+        std::string data;
+        if (!ReadFile(wxFileName(mCommonDirectory, "packed-refs").GetFullPath(), data))
+        {
+            return;
+        }
+
+        std::size_t position = 0;
+
+        while (position < data.size())
+        {
+            std::size_t lineEnd = data.find('\n', position);
+            if (lineEnd == std::string::npos)
+            {
+                lineEnd = data.size();
+            }
+
+            std::string line = data.substr(position, lineEnd - position);
+            position = lineEnd + 1;
+
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            const std::size_t separator = line.find(' ');
+
+            if (line.empty() || line[0] == '#' || line[0] == '^' || separator == std::string::npos)
+            {
+                continue;
+            }
+
+            mPackedRefs[line.substr(separator + 1)] = line.substr(0, separator);
+        }
+    }
+
+    // Tries the names git tries for "<ref>" in this order
+    bool ResolveRef(const wxString& ref, std::string& objectId)
+    {
+        wxString trimmedRef = ref;
+        trimmedRef.Trim(true).Trim(false);
+
+        const wxScopedCharBuffer utf8Ref = trimmedRef.utf8_str();
+        const std::string name(utf8Ref.data(), utf8Ref.length());
+
+        if (name.empty())
+        {
+            return false;
+        }
+
+        if (FromHex(name, objectId))
+        {
+            return true;
+        }
+
+        const std::string candidates[] = { name, "refs/" + name, "refs/tags/" + name, "refs/heads/" + name, "refs/remotes/" + name,
+                                           "refs/remotes/" + name + "/HEAD" };
+
+        for (const std::string& candidate : candidates)
+        {
+            if (ReadRef(candidate, objectId, 0))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Loose refs are files containing "<hex>" or "ref: <ref name>", per worktree or shared, otherwise packed
+    bool ReadRef(const std::string& refName, std::string& objectId, int depth)
+    {
+        if (depth >= MaxRefDepth || refName.find("..") != std::string::npos)
+        {
+            return false;
+        }
+
+        std::string content;
+        const wxString refPath = wxString::FromUTF8(refName.data(), refName.size());
+
+        if (!ReadFile(mGitDirectory + "/" + refPath, content) && !ReadFile(mCommonDirectory + "/" + refPath, content))
+        {
+            auto packedRef = mPackedRefs.find(refName);
+            if (packedRef == mPackedRefs.end())
+            {
+                return false;
+            }
+
+            content = packedRef->second;
+        }
+
+        while (!content.empty() && (content.back() == '\n' || content.back() == '\r' || content.back() == ' '))
+        {
+            content.pop_back();
+        }
+
+        if (content.compare(0, 5, "ref: ") == 0)
+        {
+            return ReadRef(content.substr(5), objectId, depth + 1);
+        }
+
+        return FromHex(content, objectId);
+    }
+
+    void OpenPacks()
+    {
+        const wxString packDirectory = wxFileName(mObjectsDirectory, "pack").GetFullPath();
+
+        wxArrayString indexPaths;
+        if (!wxDirExists(packDirectory) || wxDir::GetAllFiles(packDirectory, &indexPaths, "*.idx", wxDIR_FILES) == 0)
+        {
+            return;
+        }
+
+        for (const wxString& indexPath : indexPaths)
+        {
+            std::unique_ptr<havGSDPack> pack = std::make_unique<havGSDPack>();
+
+            // Version 2: "\377tOc", version, fanout, object IDs, CRCs, offsets, large offsets
+            unsigned char header[8 + 256 * 4];
+            if (!pack->mIndexFile.Open(indexPath) ||
+                pack->mIndexFile.Read(header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+                std::memcmp(header, "\377tOc", 4) != 0 || ReadUInt32(header + 4) != 2)
+            {
+                continue;
+            }
+
+            for (std::size_t index = 0; index < 256; ++index)
+            {
+                pack->mFanout[index] = ReadUInt32(header + 8 + index * 4);
+            }
+
+            const wxString packPath = indexPath.Left(indexPath.length() - 4) + ".pack";
+
+            if (!wxFileExists(packPath))
+            {
+                continue;
+            }
+
+            pack->mPackStream = std::make_unique<wxFileInputStream>(packPath);
+            if (!pack->mPackStream->IsOk())
+            {
+                continue;
+            }
+
+            mPacks.push_back(std::move(pack));
+        }
+    }
+
+    // Binary search in the sorted object IDs of the pack index
+    bool FindPackedObject(havGSDPack& pack, const std::string& objectId, uint64_t& offset)
+    {
+        const unsigned char firstByte = static_cast<unsigned char>(objectId[0]);
+        uint32_t first = (firstByte == 0) ? 0 : pack.mFanout[firstByte - 1];
+        uint32_t last = pack.mFanout[firstByte];
+
+        const uint32_t objectCount = pack.mFanout[255];
+        const wxFileOffset namesStart = 8 + 256 * 4;
+
+        std::string name(mHashSize, '\0');
+
+        while (first < last)
+        {
+            const uint32_t middle = first + (last - first) / 2;
+
+            if (!ReadAt(pack.mIndexFile, namesStart + static_cast<wxFileOffset>(middle) * mHashSize, &name[0], mHashSize))
+            {
+                return false;
+            }
+
+            const int comparison = name.compare(objectId);
+
+            if (comparison == 0)
+            {
+                const wxFileOffset offsetsStart = namesStart + static_cast<wxFileOffset>(objectCount) * (mHashSize + 4);
+
+                unsigned char offsetBytes[8];
+                if (!ReadAt(pack.mIndexFile, offsetsStart + static_cast<wxFileOffset>(middle) * 4, offsetBytes, 4))
+                {
+                    return false;
+                }
+
+                offset = ReadUInt32(offsetBytes);
+
+                // Offsets of 2 GiB and beyond are stored in the table of large offsets
+                if (offset & 0x80000000u)
+                {
+                    const wxFileOffset largeOffsetsStart = offsetsStart + static_cast<wxFileOffset>(objectCount) * 4;
+
+                    if (!ReadAt(pack.mIndexFile, largeOffsetsStart + static_cast<wxFileOffset>(offset & 0x7FFFFFFFu) * 8, offsetBytes, 8))
+                    {
+                        return false;
+                    }
+
+                    offset = (static_cast<uint64_t>(ReadUInt32(offsetBytes)) << 32) | ReadUInt32(offsetBytes + 4);
+                }
+
+                return true;
+            }
+
+            if (comparison < 0)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+
+        return false;
+    }
+
+    bool ReadObject(const std::string& objectId, havGSDObjectType& type, std::string& data, int depth)
+    {
+        if (objectId.size() != mHashSize || depth > MaxDeltaDepth)
+        {
+            return false;
+        }
+
+        for (std::size_t packIndex = 0; packIndex < mPacks.size(); ++packIndex)
+        {
+            uint64_t offset = 0;
+
+            if (FindPackedObject(*mPacks[packIndex], objectId, offset))
+            {
+                return ReadPackedObject(packIndex, offset, type, data, depth);
+            }
+        }
+
+        return ReadLooseObject(objectId, type, data);
+    }
+
+    // Zlib compressed "<type> <size>\0<data>" in objects/<first byte>/<rest>
+    bool ReadLooseObject(const std::string& objectId, havGSDObjectType& type, std::string& data)
+    {
+        const std::string hex = ToHex(objectId);
+        const wxString objectPath = mObjectsDirectory + "/" + wxString(hex.substr(0, 2)) + "/" + wxString(hex.substr(2));
+
+        if (!wxFileExists(objectPath))
+        {
+            return false;
+        }
+
+        wxFileInputStream fileStream(objectPath);
+        if (!fileStream.IsOk())
+        {
+            return false;
+        }
+
+        wxZlibInputStream zlibStream(fileStream, wxZLIB_ZLIB);
+
+        std::string object;
+        char buffer[64 * 1024];
+
+        do
+        {
+            zlibStream.Read(buffer, sizeof(buffer));
+            object.append(buffer, zlibStream.LastRead());
+
+            // The header ("blob 1234\0") is short
+            if (object.size() > MaxObjectSize + 64)
+            {
+                return false;
+            }
+        } while (zlibStream.LastRead() > 0);
+
+        const std::size_t typeEnd = object.find(' ');
+        const std::size_t headerEnd = object.find('\0');
+
+        if (typeEnd == std::string::npos || headerEnd == std::string::npos || typeEnd > headerEnd)
+        {
+            return false;
+        }
+
+        const std::string typeName = object.substr(0, typeEnd);
+
+        if (typeName == "commit")
+        {
+            type = havGSDObjectType::Commit;
+        }
+        else if (typeName == "tree")
+        {
+            type = havGSDObjectType::Tree;
+        }
+        else if (typeName == "blob")
+        {
+            type = havGSDObjectType::Blob;
+        }
+        else if (typeName == "tag")
+        {
+            type = havGSDObjectType::Tag;
+        }
+        else
+        {
+            return false;
+        }
+
+        // The loop above allows for the header
+        if (object.size() - headerEnd - 1 > MaxObjectSize)
+        {
+            return false;
+        }
+
+        data = object.substr(headerEnd + 1);
+
+        // The header ends with a NUL, which ends the number as well
+        return data.size() == std::strtoull(object.c_str() + typeEnd + 1, nullptr, 10);
+    }
+
+    bool ReadPackedObject(std::size_t packIndex, uint64_t offset, havGSDObjectType& type, std::string& data, int depth)
+    {
+        if (depth > MaxDeltaDepth)
+        {
+            return false;
+        }
+
+        auto cachedObject = mCache.find({ packIndex, offset });
+        if (cachedObject != mCache.end())
+        {
+            type = cachedObject->second.mType;
+            data = cachedObject->second.mData;
+            return true;
+        }
+
+        wxFileInputStream& packStream = *mPacks[packIndex]->mPackStream;
+
+        if (packStream.SeekI(static_cast<wxFileOffset>(offset)) == wxInvalidOffset)
+        {
+            return false;
+        }
+
+        // Type and size of the inflated data: 3 bits type, 4 bits size, then 7 bits size per byte
+        int byte = packStream.GetC();
+        if (byte == wxEOF)
+        {
+            return false;
+        }
+
+        const int packedType = (byte >> 4) & 0x07;
+        uint64_t size = byte & 0x0F;
+        int shift = 4;
+
+        while (byte & 0x80)
+        {
+            byte = packStream.GetC();
+            if (byte == wxEOF || shift > 57)
+            {
+                return false;
+            }
+
+            size |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        }
+
+        uint64_t baseOffset = 0;
+        std::string baseId;
+
+        if (packedType == OffsetDelta)
+        {
+            // Distance back to the base, each continuation adds one before shifting
+            byte = packStream.GetC();
+            if (byte == wxEOF)
+            {
+                return false;
+            }
+
+            uint64_t distance = byte & 0x7F;
+
+            while (byte & 0x80)
+            {
+                byte = packStream.GetC();
+                if (byte == wxEOF || distance > (UINT64_MAX >> 8))
+                {
+                    return false;
+                }
+
+                distance = ((distance + 1) << 7) | (byte & 0x7F);
+            }
+
+            if (distance == 0 || distance > offset)
+            {
+                return false;
+            }
+
+            baseOffset = offset - distance;
+        }
+        else if (packedType == RefDelta)
+        {
+            baseId.assign(mHashSize, '\0');
+            packStream.Read(&baseId[0], mHashSize);
+
+            if (packStream.LastRead() != mHashSize)
+            {
+                return false;
+            }
+        }
+        else if (packedType < static_cast<int>(havGSDObjectType::Commit) || packedType > static_cast<int>(havGSDObjectType::Tag))
+        {
+            return false;
+        }
+
+        if (size > MaxObjectSize)
+        {
+            return false;
+        }
+
+        std::string inflated(static_cast<std::size_t>(size), '\0');
+
+        if (size > 0)
+        {
+            wxZlibInputStream zlibStream(packStream, wxZLIB_ZLIB);
+            zlibStream.Read(&inflated[0], inflated.size());
+
+            if (zlibStream.LastRead() != inflated.size())
+            {
+                return false;
+            }
+        }
+
+        if (packedType == OffsetDelta || packedType == RefDelta)
+        {
+            std::string base;
+
+            const bool baseRead = (packedType == OffsetDelta) ? ReadPackedObject(packIndex, baseOffset, type, base, depth + 1)
+                                                              : ReadObject(baseId, type, base, depth + 1);
+
+            if (!baseRead || !ApplyDelta(base, inflated, data))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            type = static_cast<havGSDObjectType>(packedType);
+            data = std::move(inflated);
+        }
+
+        if (mCacheSize + data.size() > MaxCacheSize)
+        {
+            mCache.clear();
+            mCacheSize = 0;
+        }
+
+        if (data.size() <= MaxCacheSize / 4)
+        {
+            mCache[{ packIndex, offset }] = havGSDCachedObject{ type, data };
+            mCacheSize += data.size();
+        }
+
+        return true;
+    }
+
+    // Deltas start with the sizes of base and result, followed by copy and insert instructions
+    static bool ApplyDelta(const std::string& base, const std::string& delta, std::string& result)
+    {
+        std::size_t position = 0;
+        uint64_t baseSize = 0;
+        uint64_t resultSize = 0;
+
+        if (!ReadDeltaSize(delta, position, baseSize) || !ReadDeltaSize(delta, position, resultSize) || baseSize != base.size() ||
+            resultSize > MaxObjectSize)
+        {
+            return false;
+        }
+
+        result.clear();
+        result.reserve(static_cast<std::size_t>(resultSize));
+
+        while (position < delta.size())
+        {
+            const unsigned char instruction = static_cast<unsigned char>(delta[position++]);
+
+            if (instruction & 0x80)
+            {
+                // Copy from the base, the set bits tell which offset and size bytes follow
+                uint64_t copyOffset = 0;
+                uint64_t copySize = 0;
+
+                for (int bit = 0; bit < 7; ++bit)
+                {
+                    if (!(instruction & (1 << bit)))
+                    {
+                        continue;
+                    }
+
+                    if (position >= delta.size())
+                    {
+                        return false;
+                    }
+
+                    const uint64_t value = static_cast<unsigned char>(delta[position++]);
+
+                    if (bit < 4)
+                    {
+                        copyOffset |= value << (bit * 8);
+                    }
+                    else
+                    {
+                        copySize |= value << ((bit - 4) * 8);
+                    }
+                }
+
+                if (copySize == 0)
+                {
+                    copySize = 0x10000;
+                }
+
+                // Damaged deltas could otherwise repeat copies until the memory runs out
+                if (copyOffset + copySize > base.size() || result.size() + copySize > resultSize)
+                {
+                    return false;
+                }
+
+                result.append(base, static_cast<std::size_t>(copyOffset), static_cast<std::size_t>(copySize));
+            }
+            else if (instruction != 0)
+            {
+                // Insert the next bytes of the delta
+                if (position + instruction > delta.size() || result.size() + instruction > resultSize)
+                {
+                    return false;
+                }
+
+                result.append(delta, position, instruction);
+                position += instruction;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return result.size() == resultSize;
+    }
+
+    static bool ReadDeltaSize(const std::string& delta, std::size_t& position, uint64_t& size)
+    {
+        size = 0;
+        int shift = 0;
+
+        while (position < delta.size() && shift < 64)
+        {
+            const unsigned char byte = static_cast<unsigned char>(delta[position++]);
+            size |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static bool ReadAt(wxFile& file, wxFileOffset offset, void* data, std::size_t size)
+    {
+        return file.Seek(offset) != wxInvalidOffset && file.Read(data, size) == static_cast<ssize_t>(size);
+    }
+
+    static uint32_t ReadUInt32(const unsigned char* data)
+    {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+    }
+};
+
+#endif
@@ -0,0 +1,425 @@
+/*
+havGSDIoUringReader.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDIOURINGREADER_HPP
+#define HAVGSDIOURINGREADER_HPP
+
+#ifdef HAVGSD_USE_IO_URING
+
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Reads many files at once through io_uring (Linux only)
+// - Opens, stats and reads of up to MaxInFlightFiles files are queued together, which hides most of the latency on a cold page cache
+// - Every file is handed over as soon as it was read, so the order of the callbacks doesn't follow the order of the files
+// - Files which are too large or fail to read are reported separately, so they can be read with the portable reader
+// - Only small files are read whole, so the buffers of the files in flight stay below MaxInFlightFiles * MaxFileSize
+class havGSDIoUringReader
+{
+public:
+    static constexpr std::size_t MaxInFlightFiles = 32;
+    static constexpr std::size_t MaxFileSize = 256 * 1024;
+
+    havGSDIoUringReader() = default;
+
+    ~havGSDIoUringReader()
+    {
+        if (mInitialized)
+        {
+            io_uring_queue_exit(&mRing);
+        }
+    }
+
+    havGSDIoUringReader(const havGSDIoUringReader&) = delete;
+    havGSDIoUringReader& operator=(const havGSDIoUringReader&) = delete;
+
+    // Returns false, if io_uring or one of the required operations isn't available
+    bool Init()
+    {
+        // Every file needs two entries while it is opened and stated
+        if (io_uring_queue_init(MaxInFlightFiles * 2, &mRing, 0) != 0)
+        {
+            return false;
+        }
+
+        mInitialized = true;
+
+        io_uring_probe* probe = io_uring_get_probe_ring(&mRing);
+        if (probe == nullptr)
+        {
+            return false;
+        }
+
+        bool supported = io_uring_opcode_supported(probe, IORING_OP_OPENAT) &&
+                         io_uring_opcode_supported(probe, IORING_OP_STATX) &&
+                         io_uring_opcode_supported(probe, IORING_OP_READ);
+
+        io_uring_free_probe(probe);
+
+        mSlots.resize(MaxInFlightFiles);
+
+        return supported;
+    }
+
+    // Reads files[first..] and calls onFileRead(index, data, size) or onFileFailed(index) for each of them
+    template <typename FileReadCallback, typename FileFailedCallback>
+    void ReadFiles(const std::vector<wxFileName>& files, std::size_t first, const std::atomic<bool>& cancel,
+                   FileReadCallback onFileRead, FileFailedCallback onFileFailed)
+    {
+        std::size_t nextFileIndex = first;
+        std::size_t inFlightFileCount = 0;
+
+        while (true)
+        {
+            // Queue opens and stats for as many files as there are free slots
+            for (std::size_t slotIndex = 0; slotIndex < mSlots.size() && nextFileIndex < files.size() && !cancel; ++slotIndex)
+            {
+                havGSDReadSlot& slot = mSlots[slotIndex];
+
+                if (slot.mInUse)
+                {
+                    continue;
+                }
+
+                slot.mInUse = true;
+                slot.mFileIndex = nextFileIndex++;
+                slot.mPath = files[slot.mFileIndex].GetFullPath().ToStdString(wxConvFile);
+                slot.mFd = -1;
+                slot.mFailed = false;
+                slot.mPendingOperations = 2;
+                slot.mSize = 0;
+                slot.mOffset = 0;
+
+                io_uring_sqe* sqe = io_uring_get_sqe(&mRing);
+                io_uring_prep_openat(sqe, AT_FDCWD, slot.mPath.c_str(), O_RDONLY | O_CLOEXEC, 0);
+                sqe->user_data = MakeUserData(slotIndex, Operation::Open);
+
+                sqe = io_uring_get_sqe(&mRing);
+                io_uring_prep_statx(sqe, AT_FDCWD, slot.mPath.c_str(), 0, STATX_SIZE, &slot.mStat);
+                sqe->user_data = MakeUserData(slotIndex, Operation::Stat);
+
+                ++inFlightFileCount;
+            }
+
+            if (inFlightFileCount == 0)
+            {
+                // All files read or scan cancelled
+                return;
+            }
+
+            io_uring_cqe* cqe = nullptr;
+            if (io_uring_submit_and_wait(&mRing, 1) < 0 || io_uring_wait_cqe(&mRing, &cqe) != 0)
+            {
+                // The ring is unusable, hand the remaining files over to the portable reader
+                Abandon(files, nextFileIndex, onFileFailed);
+                return;
+            }
+
+            // Handle every available completion before queueing new files
+            unsigned head = 0;
+            unsigned completionCount = 0;
+
+            io_uring_for_each_cqe(&mRing, head, cqe)
+            {
+                ++completionCount;
+
+                std::uint64_t userData = cqe->user_data;
+                std::size_t slotIndex = static_cast<std::size_t>(userData >> 2);
+                Operation operation = static_cast<Operation>(userData & 3);
+
+                havGSDReadSlot& slot = mSlots[slotIndex];
+
+                switch (operation)
+                {
+                case Operation::Open:
+                    if (cqe->res >= 0)
+                    {
+                        slot.mFd = cqe->res;
+                    }
+                    else
+                    {
+                        slot.mFailed = true;
+                    }
+                    --slot.mPendingOperations;
+                    break;
+                case Operation::Stat:
+                    if (cqe->res == 0 && slot.mStat.stx_size <= MaxFileSize)
+                    {
+                        slot.mSize = static_cast<std::size_t>(slot.mStat.stx_size);
+                    }
+                    else
+                    {
+                        slot.mFailed = true;
+                    }
+                    --slot.mPendingOperations;
+                    break;
+                case Operation::Read:
+                    if (cqe->res < 0)
+                    {
+                        slot.mFailed = true;
+                    }
+                    else if (cqe->res == 0)
+                    {
+                        // File got shorter since it was stated
+                        slot.mSize = slot.mOffset;
+                    }
+                    else
+                    {
+                        slot.mOffset += static_cast<std::size_t>(cqe->res);
+                    }
+                    --slot.mPendingOperations;
+                    break;
+                }
+
+                if (slot.mPendingOperations > 0)
+                {
+                    continue;
+                }
+
+                if (!slot.mFailed && !cancel && slot.mOffset < slot.mSize)
+                {
+                    // Read (the rest of) the file
+                    slot.mBuffer.resize(slot.mSize);
+
+                    io_uring_sqe* sqe = io_uring_get_sqe(&mRing);
+                    io_uring_prep_read(sqe, slot.mFd, slot.mBuffer.data() + slot.mOffset,
+                                       static_cast<unsigned>(slot.mSize - slot.mOffset), slot.mOffset);
+                    sqe->user_data = MakeUserData(slotIndex, Operation::Read);
+
+                    slot.mPendingOperations = 1;
+                    continue;
+                }
+
+                if (slot.mFd >= 0)
+                {
+                    close(slot.mFd);
+                    slot.mFd = -1;
+                }
+
+                if (!cancel)
+                {
+                    if (slot.mFailed)
+                    {
+                        onFileFailed(slot.mFileIndex);
+                    }
+                    else
+                    {
+                        onFileRead(slot.mFileIndex, slot.mBuffer.data(), slot.mSize);
+                    }
+                }
+
+                slot.mInUse = false;
+                --inFlightFileCount;
+            }
+
+            io_uring_cq_advance(&mRing, completionCount);
+        }
+    }
+
+private:
+    enum class Operation : std::uint64_t
+    {
+        Open = 0,
+        Stat = 1,
+        Read = 2,
+        Cancel = 3 // Only queued by Abandon()
+    };
+
+    struct havGSDReadSlot
+    {
+        bool mInUse = false;
+        std::size_t mFileIndex = 0;
+        std::string mPath; // Must stay alive until the open and stat have completed
+        int mFd = -1;
+        struct statx mStat;
+        int mPendingOperations = 0;
+        bool mFailed = false;
+        std::size_t mSize = 0;
+        std::size_t mOffset = 0;
+        std::vector<char> mBuffer; // Reused for every file read through this slot
+    };
+
+    static std::uint64_t MakeUserData(std::size_t slotIndex, Operation operation)
+    {
+        return (static_cast<std::uint64_t>(slotIndex) << 2) | static_cast<std::uint64_t>(operation);
+    }
+
+    template <typename FileFailedCallback>
+    void Abandon(const std::vector<wxFileName>& files, std::size_t nextFileIndex, FileFailedCallback onFileFailed)
+    {
+        // The kernel writes into the slots until their operations have completed, even after the ring was torn down
+        std::vector<havGSDReadSlot>* slots = &mSlots;
+
+        if (!CancelInFlightOperations())
+        {
+            // The completions can't be awaited, so the slots are left to the kernel instead of being freed under it
+            slots = new std::vector<havGSDReadSlot>(std::move(mSlots));
+        }
+
+        io_uring_queue_exit(&mRing);
+        mInitialized = false;
+
+        for (auto& slot : *slots)
+        {
+            if (!slot.mInUse)
+            {
+                continue;
+            }
+
+            if (slot.mFd >= 0)
+            {
+                close(slot.mFd);
+                slot.mFd = -1;
+            }
+
+            onFileFailed(slot.mFileIndex);
+            slot.mInUse = false;
+        }
+
+        for (std::size_t index = nextFileIndex; index < files.size(); ++index)
+        {
+            onFileFailed(index);
+        }
+    }
+
+    // Cancels the operations of the slots in use and waits for their completions, returns false if the ring failed meanwhile
+    // - Completions which weren't handled yet are still in the queue and count as well
+    // - Operations which already run, like most reads of regular files, can't be cancelled and complete as usual
+    bool CancelInFlightOperations()
+    {
+        // Completions of the slot operations and of the cancellations
+        std::size_t pendingCompletionCount = 0;
+
+        for (std::size_t slotIndex = 0; slotIndex < mSlots.size(); ++slotIndex)
+        {
+            if (!mSlots[slotIndex].mInUse || mSlots[slotIndex].mPendingOperations <= 0)
+            {
+                continue;
+            }
+
+            pendingCompletionCount += static_cast<std::size_t>(mSlots[slotIndex].mPendingOperations);
+
+            // Cancelling an operation which isn't in flight fails with ENOENT, which is fine
+            for (Operation operation : { Operation::Open, Operation::Stat, Operation::Read })
+            {
+                io_uring_sqe* sqe = io_uring_get_sqe(&mRing);
+
+                if (sqe == nullptr)
+                {
+                    // Submission queue full, make room for the remaining cancellations
+                    if (!Submit())
+                    {
+                        return false;
+                    }
+
+                    sqe = io_uring_get_sqe(&mRing);
+
+                    if (sqe == nullptr)
+                    {
+                        return false;
+                    }
+                }
+
+                io_uring_prep_cancel(sqe, reinterpret_cast<void*>(static_cast<std::uintptr_t>(MakeUserData(slotIndex, operation))), 0);
+                sqe->user_data = MakeUserData(slotIndex, Operation::Cancel);
+                ++pendingCompletionCount;
+            }
+        }
+
+        while (pendingCompletionCount > 0)
+        {
+            const int result = io_uring_submit_and_wait(&mRing, 1);
+
+            if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY)
+            {
+                return false;
+            }
+
+            unsigned head = 0;
+            unsigned completionCount = 0;
+            io_uring_cqe* cqe = nullptr;
+
+            io_uring_for_each_cqe(&mRing, head, cqe)
+            {
+                ++completionCount;
+            }
+
+            io_uring_cq_advance(&mRing, completionCount);
+            pendingCompletionCount -= std::min<std::size_t>(completionCount, pendingCompletionCount);
+        }
+
+        return true;
+    }
+
+    // Returns false, if the ring can't take submissions anymore
+    bool Submit()
+    {
+        int result = 0;
+
+        do
+        {
+            result = io_uring_submit(&mRing);
+        } while (result == -EINTR);
+
+        return result >= 0;
+    }
+
+    io_uring mRing;
+    bool mInitialized = false;
+    std::vector<havGSDReadSlot> mSlots;
+};
+
+#endif
+
+#endif
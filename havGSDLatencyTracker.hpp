@@ -0,0 +1,152 @@
+/*
+havGSDLatencyTracker.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDLATENCYTRACKER_HPP
+#define HAVGSDLATENCYTRACKER_HPP
+
+#include <wx/stopwatch.h>
+#include <wx/string.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// Measures the time from an event which triggers a scan until its final results are shown in the task list
+// - Only the latest event is measured, an event replaces a pending one
+// - The last samples are kept per event, to report the median and the 99th percentile
+class havGSDLatencyTracker
+{
+public:
+    static constexpr std::size_t MaxSampleCount = 256;
+
+    struct havGSDLatencyReport
+    {
+        long mLatency;
+        long mMedian;
+        long m99thPercentile;
+        std::size_t mSampleCount;
+    };
+
+    void Start(const wxString& eventName)
+    {
+        mEventName = eventName;
+        mGeneration = 0;
+        mStopWatch.Start();
+    }
+
+    // Assigns the scan started for the pending event
+    void SetGeneration(std::size_t generation)
+    {
+        if (!mEventName.IsEmpty())
+        {
+            mGeneration = generation;
+        }
+    }
+
+    // Returns true and fills the report, if the final results of the scan of the pending event are shown
+    bool Stop(std::size_t generation, wxString& eventName, havGSDLatencyReport& report)
+    {
+        if (mGeneration == 0 || mGeneration != generation)
+        {
+            return false;
+        }
+
+        const long latency = mStopWatch.Time();
+
+        havGSDLatencySamples& latencySamples = mSamples[mEventName];
+
+        if (latencySamples.mSamples.size() < MaxSampleCount)
+        {
+            latencySamples.mSamples.push_back(latency);
+        }
+        else
+        {
+            latencySamples.mSamples[latencySamples.mNextSample] = latency;
+        }
+
+        latencySamples.mNextSample = (latencySamples.mNextSample + 1) % MaxSampleCount;
+
+        mSortedSamples = latencySamples.mSamples;
+
+        report.mLatency = latency;
+        report.mMedian = GetPercentile(50);
+        report.m99thPercentile = GetPercentile(99);
+        report.mSampleCount = mSortedSamples.size();
+
+        eventName = mEventName;
+
+        mEventName.clear();
+        mGeneration = 0;
+
+        return true;
+    }
+
+private:
+    // Ring buffer of the last samples
+    struct havGSDLatencySamples
+    {
+        std::vector<long> mSamples;
+        std::size_t mNextSample = 0;
+    };
+
+    // Nearest-rank percentile of mSortedSamples
+    long GetPercentile(std::size_t percentile)
+    {
+        const std::size_t rank = (percentile * mSortedSamples.size() + 99) / 100;
+        const std::size_t index = (rank > 0) ? rank - 1 : 0;
+
+        std::nth_element(mSortedSamples.begin(), mSortedSamples.begin() + index, mSortedSamples.end());
+
+        return mSortedSamples[index];
+    }
+
+    wxString mEventName;
+    std::size_t mGeneration = 0;
+    wxStopWatch mStopWatch;
+
+    std::map<wxString, havGSDLatencySamples> mSamples;
+
+    // Scratch buffer for the percentiles
+    std::vector<long> mSortedSamples;
+};
+
+#endif
@@ -0,0 +1,356 @@
+/*
+havGSDProtocol.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDPROTOCOL_HPP
+#define HAVGSDPROTOCOL_HPP
+
+// The scan daemon talks over a Unix domain socket, it isn't available on Windows
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVGSD_HAS_SCAN_DAEMON
+#endif
+
+#ifdef HAVGSD_HAS_SCAN_DAEMON
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Messages between the plugin and the havgsd helper process
+// Every message starts with the protocol version, its type and the payload length (all uint32, host byte order), followed by the payload
+// Strings are sent as uint32 length and UTF-8 bytes
+enum class havGSDMessageType : std::uint32_t
+{
+    // Plugin -> helper: keyword count, keywords, maximum description length, project name, open editor count, CPU budget,
+    // build running (0 or 1), file count, file paths
+    // The open editors come first, the helper moves the recently modified files of the rest to the front
+    Scan = 1,
+    // Helper -> plugin: file path, item count, items (type, line number, description)
+    FileResult = 2,
+    // Helper -> plugin: all files of a priority group (open editors, recently modified files) have been sent
+    GroupDone = 3,
+    // Helper -> plugin: all files have been sent
+    ScanDone = 4,
+    // Plugin -> helper and back: empty, the first message on every connection, so a helper of another version is noticed before scanning
+    Hello = 5,
+    // Plugin -> helper: build running (0 or 1), sent during a scan whenever a build starts or ends
+    // The helper paces the files after the priority groups like havGSDScanGovernor and pauses them during builds
+    Throttle = 6
+};
+
+class havGSDMessageWriter
+{
+public:
+    void WriteUInt32(std::uint32_t value) { mPayload.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+    void WriteString(const std::string& value)
+    {
+        WriteUInt32(static_cast<std::uint32_t>(value.size()));
+        mPayload.append(value);
+    }
+
+    void Clear() { mPayload.clear(); }
+
+    const std::string& GetPayload() const { return mPayload; }
+
+private:
+    std::string mPayload;
+};
+
+class havGSDMessageReader
+{
+public:
+    explicit havGSDMessageReader(const std::string& payload) : mPayload(payload) {}
+
+    bool ReadUInt32(std::uint32_t& value)
+    {
+        if (mPayload.size() - mOffset < sizeof(value))
+        {
+            return false;
+        }
+
+        std::memcpy(&value, mPayload.data() + mOffset, sizeof(value));
+        mOffset += sizeof(value);
+        return true;
+    }
+
+    bool ReadString(std::string& value)
+    {
+        std::uint32_t length = 0;
+        if (!ReadUInt32(length) || mPayload.size() - mOffset < length)
+        {
+            return false;
+        }
+
+        value.assign(mPayload, mOffset, length);
+        mOffset += length;
+        return true;
+    }
+
+private:
+    const std::string& mPayload;
+    std::size_t mOffset = 0;
+};
+
+class havGSDSocket
+{
+public:
+    // Upper bound for a single message, protects against a corrupted stream
+    static constexpr std::uint32_t MaxPayloadSize = 256 * 1024 * 1024;
+
+    // Messages of other versions are refused, increase it with every change of the messages
+    static constexpr std::uint32_t ProtocolVersion = 4;
+
+    explicit havGSDSocket(int fd = -1) : mFd(fd) {}
+
+    ~havGSDSocket() { Close(); }
+
+    havGSDSocket(const havGSDSocket&) = delete;
+    havGSDSocket& operator=(const havGSDSocket&) = delete;
+
+    havGSDSocket(havGSDSocket&& other) noexcept : mFd(other.mFd) { other.mFd = -1; }
+
+    // One helper process per user, shared by all CodeLite instances
+    // The socket and its lock file live in a directory only the user can access, see MakePrivateDirectory()
+    static std::string GetDefaultDirectory()
+    {
+        const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+        if (runtimeDir != nullptr && runtimeDir[0] != '\0')
+        {
+            return std::string(runtimeDir) + "/havgsd";
+        }
+
+        return "/tmp/havgsd-" + std::to_string(geteuid());
+    }
+
+    // The name contains the protocol version, so an updated plugin starts its own helper instead of using an older one
+    static std::string GetDefaultPath() { return GetDefaultDirectory() + "/havgsd-" + std::to_string(ProtocolVersion) + ".sock"; }
+
+    // Creates the directory with mode 0700 if it doesn't exist yet, returns false unless it is a real directory
+    // owned by the user which nobody else can access, so another user can't plant a socket or a symbolic link in it
+    static bool MakePrivateDirectory(const std::string& path)
+    {
+        if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST)
+        {
+            return false;
+        }
+
+        struct stat status;
+        return lstat(path.c_str(), &status) == 0 &&
+               S_ISDIR(status.st_mode) &&
+               status.st_uid == geteuid() &&
+               (status.st_mode & 077) == 0;
+    }
+
+    static bool MakeAddress(const std::string& path, sockaddr_un& address)
+    {
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            return false;
+        }
+
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    bool Connect(const std::string& path)
+    {
+        Close();
+
+        sockaddr_un address;
+        if (!MakeAddress(path, address))
+        {
+            return false;
+        }
+
+        mFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (mFd < 0)
+        {
+            return false;
+        }
+
+        DisableSigPipe();
+
+        if (connect(mFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Close()
+    {
+        if (mFd >= 0)
+        {
+            close(mFd);
+            mFd = -1;
+        }
+    }
+
+    bool IsOk() const { return mFd >= 0; }
+
+    // Returns true if the process on the other end runs as the same user
+    bool IsPeerCurrentUser() const
+    {
+#if defined(__linux__)
+        ucred credentials;
+        socklen_t length = sizeof(credentials);
+        if (getsockopt(mFd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+        {
+            return false;
+        }
+
+        return credentials.uid == geteuid();
+#else
+        uid_t peerUid = 0;
+        gid_t peerGid = 0;
+        if (getpeereid(mFd, &peerUid, &peerGid) != 0)
+        {
+            return false;
+        }
+
+        return peerUid == geteuid();
+#endif
+    }
+
+    int GetFd() const { return mFd; }
+
+    bool SendMessage(havGSDMessageType type, const std::string& payload)
+    {
+        std::uint32_t header[3] = { ProtocolVersion, static_cast<std::uint32_t>(type), static_cast<std::uint32_t>(payload.size()) };
+
+        return SendAll(header, sizeof(header)) && SendAll(payload.data(), payload.size());
+    }
+
+    bool ReceiveMessage(havGSDMessageType& type, std::string& payload)
+    {
+        std::uint32_t header[3] = { 0, 0, 0 };
+
+        if (!ReceiveAll(header, sizeof(header)) || header[0] != ProtocolVersion || header[2] > MaxPayloadSize)
+        {
+            return false;
+        }
+
+        type = static_cast<havGSDMessageType>(header[1]);
+        payload.resize(header[2]);
+
+        return ReceiveAll(&payload[0], payload.size());
+    }
+
+    void DisableSigPipe()
+    {
+#ifdef SO_NOSIGPIPE
+        int value = 1;
+        setsockopt(mFd, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+#endif
+    }
+
+private:
+    bool SendAll(const void* data, std::size_t size)
+    {
+#ifdef MSG_NOSIGNAL
+        const int flags = MSG_NOSIGNAL;
+#else
+        const int flags = 0;
+#endif
+        const char* bytes = static_cast<const char*>(data);
+
+        while (size > 0)
+        {
+            ssize_t sent = send(mFd, bytes, size, flags);
+            if (sent < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (sent <= 0)
+            {
+                return false;
+            }
+
+            bytes += sent;
+            size -= static_cast<std::size_t>(sent);
+        }
+
+        return true;
+    }
+
+    bool ReceiveAll(void* data, std::size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+
+        while (size > 0)
+        {
+            ssize_t received = recv(mFd, bytes, size, 0);
+            if (received < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (received <= 0)
+            {
+                return false;
+            }
+
+            bytes += received;
+            size -= static_cast<std::size_t>(received);
+        }
+
+        return true;
+    }
+
+    int mFd;
+};
+
+#endif
+
+#endif
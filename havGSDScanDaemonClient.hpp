@@ -0,0 +1,356 @@
+/*
+havGSDScanDaemonClient.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDSCANDAEMONCLIENT_HPP
+#define HAVGSDSCANDAEMONCLIENT_HPP
+
+#include "havGSDProtocol.hpp"
+
+#ifdef HAVGSD_HAS_SCAN_DAEMON
+
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "havGSDScanGovernor.hpp"
+#include "havGSDScanner.hpp"
+
+// Runs scans in the havgsd helper process
+// - The helper is shared by all CodeLite instances of the user and keeps its own result cache
+// - It is started on first use and exits by itself once it has been idle for a while
+class havGSDScanDaemonClient
+{
+public:
+    explicit havGSDScanDaemonClient(const wxString& daemonPath) : mDaemonPath(daemonPath.ToStdString(wxConvFile)) {}
+    ~havGSDScanDaemonClient() = default;
+
+    // Connects to the running helper process or starts it, nothing is sent unless the helper runs as the same user
+    // and answers with the same protocol version
+    bool Connect(const std::atomic<bool>& cancel)
+    {
+        if (!havGSDSocket::MakePrivateDirectory(havGSDSocket::GetDefaultDirectory()))
+        {
+            return false;
+        }
+
+        const std::string socketPath = havGSDSocket::GetDefaultPath();
+
+        if (ConnectToCurrentUser(socketPath))
+        {
+            return true;
+        }
+
+        if (!StartDaemon())
+        {
+            return false;
+        }
+
+        // Give the helper some time to create its socket
+        for (int attempt = 0; attempt < 100 && !cancel; ++attempt)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+            if (ConnectToCurrentUser(socketPath))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Returns false, if the connection broke before the scan was complete
+    // - The files of open editors are at the front, the helper orders the remaining files itself
+    // - The helper follows the CPU budget and the builds of the governor, it is told when a build starts or ends
+    template <typename GroupDoneCallback>
+    bool Scan(const std::vector<wxFileName>& files, std::size_t openEditorCount, const std::vector<wxString>& keywords,
+              std::size_t maxDescriptionLength, const wxString& projectName, havGSDScanGovernor& scanGovernor,
+              const std::atomic<bool>& cancel, std::vector<havGSDFileItem>& fileItems, GroupDoneCallback onGroupDone)
+    {
+        bool buildRunning = scanGovernor.IsBuildRunning();
+
+        havGSDMessageWriter writer;
+
+        writer.WriteUInt32(static_cast<std::uint32_t>(keywords.size()));
+        for (const auto& keyword : keywords)
+        {
+            writer.WriteString(keyword.ToStdString(wxConvUTF8));
+        }
+
+        writer.WriteUInt32(static_cast<std::uint32_t>(maxDescriptionLength));
+
+        writer.WriteString(projectName.ToStdString(wxConvUTF8));
+        writer.WriteUInt32(static_cast<std::uint32_t>(openEditorCount));
+        writer.WriteUInt32(static_cast<std::uint32_t>(scanGovernor.GetCpuBudget()));
+        writer.WriteUInt32(buildRunning ? 1 : 0);
+
+        writer.WriteUInt32(static_cast<std::uint32_t>(files.size()));
+        for (const auto& file : files)
+        {
+            writer.WriteString(file.GetFullPath().ToStdString(wxConvUTF8));
+        }
+
+        if (!mSocket.SendMessage(havGSDMessageType::Scan, writer.GetPayload()))
+        {
+            return false;
+        }
+
+        havGSDMessageType type;
+        std::string payload;
+
+        while (true)
+        {
+            if (scanGovernor.IsBuildRunning() != buildRunning)
+            {
+                buildRunning = !buildRunning;
+
+                writer.Clear();
+                writer.WriteUInt32(buildRunning ? 1 : 0);
+
+                if (!mSocket.SendMessage(havGSDMessageType::Throttle, writer.GetPayload()))
+                {
+                    return false;
+                }
+            }
+
+            // Wait in short steps, so a cancelled scan doesn't block the UI thread which waits for it and builds are noticed
+            pollfd pollFd = { mSocket.GetFd(), POLLIN, 0 };
+
+            int ready = poll(&pollFd, 1, 100);
+
+            if (cancel)
+            {
+                return true;
+            }
+
+            if (ready < 0 && errno != EINTR)
+            {
+                return false;
+            }
+
+            if (ready <= 0)
+            {
+                continue;
+            }
+
+            if (!mSocket.ReceiveMessage(type, payload))
+            {
+                return false;
+            }
+
+            switch (type)
+            {
+            case havGSDMessageType::FileResult:
+                if (!ReadFileResult(payload, projectName, fileItems))
+                {
+                    return false;
+                }
+                break;
+            case havGSDMessageType::GroupDone:
+                onGroupDone();
+                break;
+            case havGSDMessageType::ScanDone:
+                return true;
+            default:
+                // Unknown message
+                return false;
+            }
+        }
+    }
+
+private:
+    // Upper bound for the answer to Hello
+    static constexpr int HandshakeTimeout = 1000;
+
+    bool ConnectToCurrentUser(const std::string& socketPath)
+    {
+        if (!mSocket.Connect(socketPath))
+        {
+            return false;
+        }
+
+        if (!mSocket.IsPeerCurrentUser() || !Handshake())
+        {
+            mSocket.Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    // A helper of another version drops the connection instead of answering, see havGSDSocket::ReceiveMessage()
+    bool Handshake()
+    {
+        if (!mSocket.SendMessage(havGSDMessageType::Hello, std::string()))
+        {
+            return false;
+        }
+
+        pollfd pollFd = { mSocket.GetFd(), POLLIN, 0 };
+
+        int ready = 0;
+        do
+        {
+            ready = poll(&pollFd, 1, HandshakeTimeout);
+        } while (ready < 0 && errno == EINTR);
+
+        havGSDMessageType type;
+        std::string payload;
+
+        return ready > 0 && mSocket.ReceiveMessage(type, payload) && type == havGSDMessageType::Hello;
+    }
+
+    bool ReadFileResult(const std::string& payload, const wxString& projectName, std::vector<havGSDFileItem>& fileItems)
+    {
+        havGSDMessageReader reader(payload);
+
+        std::uint32_t itemCount = 0;
+        if (!reader.ReadString(mPath) || !reader.ReadUInt32(itemCount))
+        {
+            return false;
+        }
+
+        const wxFileName file(wxString::FromUTF8(mPath.data(), mPath.size()));
+        const wxString fileName = file.GetFullName();
+        const wxString filePath = file.GetFullPath();
+
+        for (std::uint32_t index = 0; index < itemCount; ++index)
+        {
+            std::uint32_t lineNumber = 0;
+
+            if (!reader.ReadString(mType) || !reader.ReadUInt32(lineNumber) || !reader.ReadString(mDescription))
+            {
+                return false;
+            }
+
+            havGSDFileItem fileItem;
+            fileItem.mType = wxString::FromUTF8(mType.data(), mType.size());
+            fileItem.mProjectName = projectName;
+            fileItem.mFileName = fileName;
+            fileItem.mFilePath = filePath;
+            fileItem.mDescription = wxString::FromUTF8(mDescription.data(), mDescription.size());
+            fileItem.mLine = wxString::Format("%u", lineNumber);
+
+            fileItems.push_back(std::move(fileItem));
+        }
+
+        return true;
+    }
+
+    bool StartDaemon()
+    {
+        // The pipe is closed by a successful exec, a failed one writes to it, so a missing helper is noticed right away
+        int execPipe[2];
+        if (pipe(execPipe) != 0)
+        {
+            return false;
+        }
+
+        fcntl(execPipe[0], F_SETFD, FD_CLOEXEC);
+        fcntl(execPipe[1], F_SETFD, FD_CLOEXEC);
+
+        // Detach the helper from CodeLite with a double fork, so it keeps running for other instances
+        pid_t child = fork();
+        if (child < 0)
+        {
+            close(execPipe[0]);
+            close(execPipe[1]);
+            return false;
+        }
+
+        if (child == 0)
+        {
+            setsid();
+
+            pid_t grandChild = fork();
+            if (grandChild == 0)
+            {
+                execl(mDaemonPath.c_str(), mDaemonPath.c_str(), static_cast<char*>(nullptr));
+
+                const char failed = 1;
+                [[maybe_unused]] ssize_t written = write(execPipe[1], &failed, 1);
+                _exit(127);
+            }
+
+            _exit(grandChild < 0 ? 1 : 0);
+        }
+
+        close(execPipe[1]);
+
+        int status = 0;
+        while (waitpid(child, &status, 0) < 0 && errno == EINTR)
+        {
+        }
+
+        char failed = 0;
+        ssize_t received = 0;
+        do
+        {
+            received = read(execPipe[0], &failed, 1);
+        } while (received < 0 && errno == EINTR);
+
+        close(execPipe[0]);
+
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0 && received == 0;
+    }
+
+    std::string mDaemonPath;
+    havGSDSocket mSocket;
+
+    // Scratch buffers for decoding results
+    std::string mPath;
+    std::string mType;
+    std::string mDescription;
+};
+
+#endif
+
+#endif
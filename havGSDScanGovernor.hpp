@@ -0,0 +1,206 @@
+/*
+havGSDScanGovernor.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDSCANGOVERNOR_HPP
+#define HAVGSDSCANGOVERNOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#if defined(__WXMSW__)
+#include <wx/msw/wrapwin.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Keeps the background passes of a scan from competing with builds and the IDE
+// - While a build is running, the scan pauses and its thread runs with low priority (CPU and I/O on Windows, I/O on Linux)
+// - Otherwise the scan sleeps between files, so it uses no more than the CPU budget of one core
+class havGSDScanGovernor
+{
+public:
+    static constexpr int MinCpuBudget = 5;
+    static constexpr int MaxCpuBudget = 100;
+
+    // Called by the UI
+    void SetBuildRunning(bool buildRunning)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mBuildRunning = buildRunning;
+        }
+
+        mCondition.notify_all();
+    }
+
+    void SetCpuBudget(int cpuBudget)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCpuBudget = std::clamp(cpuBudget, MinCpuBudget, MaxCpuBudget);
+    }
+
+    bool IsBuildRunning()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mBuildRunning;
+    }
+
+    int GetCpuBudget()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCpuBudget;
+    }
+
+    // Wakes a paused or sleeping scan, so it notices it was cancelled
+    void Wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+        }
+
+        mCondition.notify_all();
+    }
+
+    // Called by the scan thread before the first file of a background pass
+    void Begin()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWorkStart = Clock::now();
+        mSleepDebt = Clock::duration::zero();
+        mBackgroundPriority = false;
+    }
+
+    // Called by the scan thread between files, returns false if the scan was cancelled meanwhile
+    bool Throttle(const std::atomic<bool>& cancel)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        const Clock::time_point now = Clock::now();
+        const Clock::duration work = now - mWorkStart;
+
+        if (mBuildRunning)
+        {
+            SetBackgroundPriority(true);
+
+            // Wait in short steps, cancelling a scan doesn't take the lock
+            while (mBuildRunning && !cancel)
+            {
+                mCondition.wait_for(lock, WaitStep);
+            }
+
+            mSleepDebt = Clock::duration::zero();
+        }
+        else if (mCpuBudget < MaxCpuBudget)
+        {
+            // Sleeping (100 - budget) / budget of the time worked keeps the scan at the budget
+            mSleepDebt += work * (MaxCpuBudget - mCpuBudget) / mCpuBudget;
+
+            if (mSleepDebt >= MinSleep)
+            {
+                const Clock::time_point sleepEnd = now + std::min<Clock::duration>(mSleepDebt, MaxSleep);
+
+                while (!mBuildRunning && !cancel && Clock::now() < sleepEnd)
+                {
+                    mCondition.wait_until(lock, std::min(sleepEnd, Clock::now() + WaitStep));
+                }
+
+                mSleepDebt = Clock::duration::zero();
+            }
+        }
+
+        if (!mBuildRunning)
+        {
+            SetBackgroundPriority(false);
+        }
+
+        mWorkStart = Clock::now();
+
+        return !cancel;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds WaitStep{ 100 };
+    static constexpr std::chrono::milliseconds MinSleep{ 10 };
+    static constexpr std::chrono::milliseconds MaxSleep{ 1000 };
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    bool mBuildRunning = false;
+    int mCpuBudget = MaxCpuBudget;
+
+    // Only accessed by the scan thread
+    Clock::time_point mWorkStart;
+    Clock::duration mSleepDebt = Clock::duration::zero();
+    bool mBackgroundPriority = false;
+
+    // Lowers or restores the priority of the calling thread, a best effort, failures are ignored
+    void SetBackgroundPriority(bool backgroundPriority)
+    {
+        if (mBackgroundPriority == backgroundPriority)
+        {
+            return;
+        }
+
+        mBackgroundPriority = backgroundPriority;
+
+#if defined(__WXMSW__)
+        // Lowers the I/O and memory priority as well
+        SetThreadPriority(GetCurrentThread(), backgroundPriority ? THREAD_MODE_BACKGROUND_BEGIN : THREAD_MODE_BACKGROUND_END);
+#elif defined(__linux__)
+#ifdef SYS_ioprio_set
+        // Only the I/O priority, unprivileged users can't raise a nice value again once it was lowered
+        // IOPRIO_WHO_PROCESS applies to the thread, IOPRIO_CLASS_IDLE or IOPRIO_CLASS_NONE
+        const int threadId = static_cast<int>(syscall(SYS_gettid));
+        const int ioPriority = backgroundPriority ? (3 << 13) : 0;
+        syscall(SYS_ioprio_set, 1, threadId, ioPriority);
+#endif
+#endif
+    }
+};
+
+#endif
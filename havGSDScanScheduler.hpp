@@ -0,0 +1,135 @@
+/*
+havGSDScanScheduler.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDSCANSCHEDULER_HPP
+#define HAVGSDSCANSCHEDULER_HPP
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <unordered_set>
+#include <vector>
+
+struct havGSDScanSchedule
+{
+    std::size_t mOpenEditorCount = 0;
+    std::size_t mRecentlyModifiedCount = 0;
+};
+
+class havGSDScanScheduler
+{
+public:
+    // Files modified within this many seconds count as recently modified
+    static constexpr std::time_t DefaultRecentWindow = 24 * 60 * 60;
+
+    explicit havGSDScanScheduler(std::time_t recentWindow = DefaultRecentWindow) : mRecentWindow(recentWindow) {}
+    ~havGSDScanScheduler() = default;
+
+    void AddOpenEditor(const wxFileName& fileName)
+    {
+        mOpenEditors.insert(fileName.GetFullPath());
+    }
+
+    // Moves the files of open editors to the front and keeps the project order otherwise, returns their count
+    // Only compares paths, so the open editors can be scanned before any other file is looked at
+    std::size_t MoveOpenEditorsToFront(std::vector<wxFileName>& files) const
+    {
+        auto openEditorsEnd = std::stable_partition(files.begin(), files.end(),
+            [this](const wxFileName& file) { return mOpenEditors.count(file.GetFullPath()) != 0; });
+
+        return static_cast<std::size_t>(openEditorsEnd - files.begin());
+    }
+
+    // Reorders the files from begin on, recently modified files come first (newest first), followed by the
+    // remaining files in their original project order, returns the count of recently modified files
+    // Reads the modification time of every file, so it runs on the scan thread, once cancelled the times aren't read anymore
+    std::size_t MoveRecentlyModifiedToFront(std::vector<wxFileName>& files, std::size_t begin, const std::atomic<bool>& cancel) const
+    {
+        std::vector<std::pair<std::time_t, wxFileName>> recentlyModifiedFiles;
+        std::vector<wxFileName> remainingFiles;
+
+        const std::time_t now = std::time(nullptr);
+
+        for (std::size_t index = begin; index < files.size(); ++index)
+        {
+            wxFileName& file = files[index];
+
+            std::time_t modificationTime = cancel ? static_cast<std::time_t>(-1) : wxFileModificationTime(file.GetFullPath());
+
+            if (modificationTime != static_cast<std::time_t>(-1) && (now - modificationTime) <= mRecentWindow)
+            {
+                recentlyModifiedFiles.emplace_back(modificationTime, std::move(file));
+                continue;
+            }
+
+            remainingFiles.push_back(std::move(file));
+        }
+
+        // Newest first, keep project order for equal timestamps
+        std::stable_sort(recentlyModifiedFiles.begin(), recentlyModifiedFiles.end(),
+            [](const auto& left, const auto& right) { return left.first > right.first; });
+
+        files.resize(begin);
+        files.reserve(begin + recentlyModifiedFiles.size() + remainingFiles.size());
+
+        for (auto& [modificationTime, file] : recentlyModifiedFiles)
+        {
+            files.push_back(std::move(file));
+        }
+
+        for (auto& file : remainingFiles)
+        {
+            files.push_back(std::move(file));
+        }
+
+        return recentlyModifiedFiles.size();
+    }
+
+private:
+    std::unordered_set<wxString> mOpenEditors;
+    std::time_t mRecentWindow;
+};
+
+#endif
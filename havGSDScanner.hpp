@@ -0,0 +1,521 @@
+/*
+havGSDScanner.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDSCANNER_HPP
+#define HAVGSDSCANNER_HPP
+
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/regex.h>
+#include <wx/strconv.h>
+#include <wx/string.h>
+#include <wx/txtstrm.h>
+#include <wx/wfstream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "havGSDCommentLexer.hpp"
+
+struct havGSDFileItem
+{
+    wxString mType;
+    wxString mProjectName;
+    wxString mFileName;
+    wxString mFilePath;
+    wxString mDescription;
+    wxString mLine;
+};
+
+// Scans files for keywords in comments, the comment syntax is chosen by the language of the file
+// - One scanner is used per scan and per worker, it is not thread-safe
+// - Files are read in chunks and lines longer than a segment are scanned in pieces, so memory use doesn't depend on the file
+// - Scratch buffers are kept between files, so the bookkeeping doesn't allocate once they have grown to size
+// - A cancelled scan stops between chunks, the items of the file being scanned are incomplete then
+class havGSDScanner
+{
+public:
+    static constexpr std::size_t ChunkSize = 64 * 1024;
+    static constexpr std::size_t MaxSegmentLength = 16 * 1024;
+
+    havGSDScanner() = default;
+    ~havGSDScanner() = default;
+
+    // Descriptions are cut after maxDescriptionLength characters, 0 keeps them whole
+    bool Init(const std::vector<wxString>& keywords, std::size_t maxDescriptionLength)
+    {
+        mKeywords = keywords;
+        mKeywordTypes.clear();
+        mMaxDescriptionLength = maxDescriptionLength;
+
+        if (mKeywords.empty())
+        {
+            // Keyword list is empty
+            return false;
+        }
+
+        // The keyword ID is the index in the keyword list, compute the displayed type once per keyword
+        for (const auto& keyword : mKeywords)
+        {
+            mKeywordTypes.push_back(keyword.Upper().Trim(false).Trim());
+        }
+
+        // One bit per keyword ID
+        mMatchedKeywords.assign((mKeywords.size() + 63) / 64, 0);
+
+        // Build regex to match keywords in comments
+        wxString regexPattern = "\\b(" + wxJoin(mKeywords, '|') + ")\\b";
+
+        // Case-insensitive regex
+        if (!mRegex.Compile(regexPattern, wxRE_ICASE))
+        {
+            // Invalid generated regex
+            return false;
+        }
+
+        return true;
+    }
+
+    // Checked between chunks, so cancelling doesn't wait for a large file to be scanned
+    void SetCancel(const std::atomic<bool>* cancel) { mCancel = cancel; }
+
+    // Only the selected lines are reported if given (1-based)
+    void ScanFile(const wxFileName& file, const wxString& projectName, std::vector<havGSDFileItem>& fileItems,
+                  const std::vector<bool>* selectedLines = nullptr)
+    {
+        if (!file.FileExists())
+        {
+            // File doesn't exist
+            return;
+        }
+
+        wxFileInputStream fileStream(file.GetFullPath());
+        if (!fileStream.IsOk())
+        {
+            // Couldn't open file
+            return;
+        }
+
+        havGSDFileScan fileScan(file, projectName, fileItems);
+        fileScan.mSelectedLines = selectedLines;
+
+        mChunk.resize(ChunkSize);
+
+        std::size_t chunkSize = ReadChunk(fileStream);
+
+        if (IsWideText(mChunk.data(), chunkSize))
+        {
+            fileStream.SeekI(0);
+            ScanWideText(fileStream, fileScan);
+            return;
+        }
+
+        std::size_t offset = GetUtf8BomLength(mChunk.data(), chunkSize);
+
+        while (chunkSize > 0)
+        {
+            if (IsCancelled())
+            {
+                return;
+            }
+
+            ScanBytes(fileScan, mChunk.data() + offset, chunkSize - offset);
+
+            chunkSize = ReadChunk(fileStream);
+            offset = 0;
+        }
+
+        EndFile(fileScan);
+    }
+
+    // Scans the contents of a file which has already been read into memory, only the selected lines are reported if given (1-based)
+    void ScanBuffer(const wxFileName& file, const char* data, std::size_t size, const wxString& projectName, std::vector<havGSDFileItem>& fileItems,
+                    const std::vector<bool>* selectedLines = nullptr)
+    {
+        havGSDFileScan fileScan(file, projectName, fileItems);
+        fileScan.mSelectedLines = selectedLines;
+
+        if (IsWideText(data, size))
+        {
+            wxMemoryInputStream memoryStream(data, size);
+            ScanWideText(memoryStream, fileScan);
+            return;
+        }
+
+        for (std::size_t offset = GetUtf8BomLength(data, size); offset < size; offset += ChunkSize)
+        {
+            if (IsCancelled())
+            {
+                return;
+            }
+
+            ScanBytes(fileScan, data + offset, std::min(ChunkSize, size - offset));
+        }
+
+        EndFile(fileScan);
+    }
+
+private:
+    // Words longer than this are cut when a long line is split into segments
+    static constexpr std::size_t MaxCarriedWordLength = 64;
+
+    // State of the file being scanned, carried from one chunk to the next
+    struct havGSDFileScan
+    {
+        havGSDFileScan(const wxFileName& file, const wxString& projectName, std::vector<havGSDFileItem>& fileItems)
+            : mCommentLexer(havGSDLanguageTable::Get().Find(file)), mProjectName(projectName), mFileName(file.GetFullName()),
+              mFilePath(file.GetFullPath()), mFileItems(fileItems)
+        {
+        }
+
+        const havGSDCommentLexer& mCommentLexer;
+        const wxString& mProjectName;
+        const wxString mFileName;
+        const wxString mFilePath;
+        std::vector<havGSDFileItem>& mFileItems;
+
+        havGSDCommentLexer::State mState = havGSDCommentLexer::CodeState;
+        std::size_t mLineNumber = 1;
+        bool mLineMatched = false;
+
+        // Lines to report, all if not set, comments are still followed through the other lines
+        const std::vector<bool>* mSelectedLines = nullptr;
+
+        // Part of the current segment covered by comments
+        std::size_t mCommentStart = std::string::npos;
+        std::size_t mCommentEnd = 0;
+    };
+
+    bool IsCancelled() const { return mCancel != nullptr && *mCancel; }
+
+    std::size_t ReadChunk(wxInputStream& stream)
+    {
+        stream.Read(mChunk.data(), ChunkSize);
+        return stream.LastRead();
+    }
+
+    static std::size_t GetUtf8BomLength(const char* data, std::size_t size)
+    {
+        return (size >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF') ? 3 : 0;
+    }
+
+    // UTF-16 and UTF-32 text, recognized by the byte order mark
+    static bool IsWideText(const char* data, std::size_t size)
+    {
+        return size >= 2 && ((data[0] == '\xFF' && data[1] == '\xFE') || (data[0] == '\xFE' && data[1] == '\xFF') ||
+                             (size >= 4 && data[0] == '\0' && data[1] == '\0' && data[2] == '\xFE' && data[3] == '\xFF'));
+    }
+
+    // Wide text is rare in projects, it is converted line by line to UTF-8 and scanned like any other file
+    void ScanWideText(wxInputStream& stream, havGSDFileScan& fileScan)
+    {
+        wxTextInputStream textStream(stream);
+
+        for (std::size_t lineCount = 1; !stream.Eof(); ++lineCount)
+        {
+            if (lineCount % 1024 == 0 && IsCancelled())
+            {
+                return;
+            }
+
+            const wxScopedCharBuffer line = textStream.ReadLine().utf8_str();
+
+            ScanBytes(fileScan, line.data(), line.length());
+            ScanBytes(fileScan, "\n", 1);
+        }
+
+        EndFile(fileScan);
+    }
+
+    void ScanBytes(havGSDFileScan& fileScan, const char* data, std::size_t size)
+    {
+        const havGSDCommentLexer& commentLexer = fileScan.mCommentLexer;
+
+        for (std::size_t index = 0; index < size; ++index)
+        {
+            const char character = data[index];
+
+            if (character == '\n')
+            {
+                EndSegment(fileScan, true);
+                continue;
+            }
+
+            if (mSegment.length() == MaxSegmentLength)
+            {
+                EndSegment(fileScan, false);
+            }
+
+            const havGSDCommentLexer::State nextState = commentLexer.Next(fileScan.mState, static_cast<unsigned char>(character));
+
+            if (commentLexer.IsComment(fileScan.mState) || commentLexer.IsComment(nextState))
+            {
+                if (fileScan.mCommentStart == std::string::npos)
+                {
+                    fileScan.mCommentStart = mSegment.length();
+                }
+
+                fileScan.mCommentEnd = mSegment.length() + 1;
+            }
+
+            fileScan.mState = nextState;
+            mSegment += character;
+        }
+    }
+
+    void EndFile(havGSDFileScan& fileScan)
+    {
+        // Last line without a line break
+        if (!mSegment.empty())
+        {
+            EndSegment(fileScan, true);
+        }
+    }
+
+    // Matches the collected segment, which is either a whole line or a piece of a long line
+    void EndSegment(havGSDFileScan& fileScan, bool endOfLine)
+    {
+        std::size_t segmentLength = mSegment.length();
+
+        if (!endOfLine)
+        {
+            // Don't cut a keyword in two, a short word at the end moves to the next segment
+            std::size_t wordStart = segmentLength;
+
+            while (wordStart > 0 && segmentLength - wordStart < MaxCarriedWordLength && IsWordByte(mSegment[wordStart - 1]))
+            {
+                --wordStart;
+            }
+
+            if (wordStart > 0 && segmentLength - wordStart < MaxCarriedWordLength)
+            {
+                segmentLength = wordStart;
+            }
+        }
+
+        if (fileScan.mCommentStart < segmentLength)
+        {
+            MatchSegment(fileScan, segmentLength, std::min(fileScan.mCommentEnd, segmentLength));
+        }
+
+        if (endOfLine)
+        {
+            mSegment.clear();
+            fileScan.mCommentStart = std::string::npos;
+            fileScan.mCommentEnd = 0;
+            fileScan.mState = fileScan.mCommentLexer.EndLine(fileScan.mState);
+            fileScan.mLineMatched = false;
+            ++fileScan.mLineNumber;
+            return;
+        }
+
+        // Keep the carried word and its part of the comment
+        mSegment.erase(0, segmentLength);
+
+        if (fileScan.mCommentStart != std::string::npos && fileScan.mCommentEnd > segmentLength)
+        {
+            fileScan.mCommentStart = (fileScan.mCommentStart > segmentLength) ? fileScan.mCommentStart - segmentLength : 0;
+            fileScan.mCommentEnd -= segmentLength;
+        }
+        else
+        {
+            fileScan.mCommentStart = std::string::npos;
+            fileScan.mCommentEnd = 0;
+        }
+    }
+
+    // Bytes of UTF-8 sequences count as word bytes, so they aren't split either
+    static bool IsWordByte(char character)
+    {
+        const unsigned char byte = static_cast<unsigned char>(character);
+        return byte >= 0x80 || byte == '_' || (byte >= '0' && byte <= '9') || (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z');
+    }
+
+    // Text which isn't valid UTF-8 is read as Latin-1
+    static wxString Decode(const char* data, std::size_t length)
+    {
+        wxString text = wxString::FromUTF8(data, length);
+
+        if (text.IsEmpty() && length > 0)
+        {
+            text = wxString(data, wxConvISO8859_1, length);
+        }
+
+        return text;
+    }
+
+    // Decodes like Decode() into mComment, whose buffers are kept, so matching the comments of a scan doesn't allocate
+    // Neither UTF-8 nor Latin-1 decodes to more characters than bytes
+    const wxString& DecodeComment(const char* data, std::size_t length)
+    {
+        if (length == 0)
+        {
+            mComment.clear();
+            return mComment;
+        }
+
+        if (mCommentChars.size() < length)
+        {
+            mCommentChars.resize(length);
+        }
+
+        std::size_t commentLength = wxConvUTF8.ToWChar(mCommentChars.data(), mCommentChars.size(), data, length);
+
+        if (commentLength == wxCONV_FAILED)
+        {
+            commentLength = wxConvISO8859_1.ToWChar(mCommentChars.data(), mCommentChars.size(), data, length);
+        }
+
+        mComment.assign(mCommentChars.data(), (commentLength == wxCONV_FAILED) ? 0 : commentLength);
+        return mComment;
+    }
+
+    // Returns the keyword ID of the given text or -1, if it isn't in the keyword list
+    int FindKeyword(const wxChar* text, std::size_t length) const
+    {
+        for (std::size_t keywordId = 0; keywordId < mKeywords.size(); ++keywordId)
+        {
+            const wxString& keyword = mKeywords[keywordId];
+
+            if (keyword.length() == length && std::char_traits<wxChar>::compare(keyword.wc_str(), text, length) == 0)
+            {
+                return static_cast<int>(keywordId);
+            }
+        }
+
+        return -1;
+    }
+
+    // Keywords are searched in the comment part of the segment, the description is the whole segment
+    void MatchSegment(havGSDFileScan& fileScan, std::size_t segmentLength, std::size_t commentEnd)
+    {
+        if (fileScan.mSelectedLines &&
+            (fileScan.mLineNumber >= fileScan.mSelectedLines->size() || !(*fileScan.mSelectedLines)[fileScan.mLineNumber]))
+        {
+            return;
+        }
+
+        const wxString& comment = DecodeComment(mSegment.data() + fileScan.mCommentStart, commentEnd - fileScan.mCommentStart);
+
+        if (!mRegex.Matches(comment))
+        {
+            return;
+        }
+
+        // Track which keywords have already been processed for this line
+        if (!fileScan.mLineMatched)
+        {
+            std::fill(mMatchedKeywords.begin(), mMatchedKeywords.end(), 0);
+            fileScan.mLineMatched = true;
+        }
+
+        wxString description;
+
+        // Capture all matches in the line
+        for (std::size_t index = 0; index < mRegex.GetMatchCount(); ++index)
+        {
+            std::size_t matchStart = 0;
+            std::size_t matchLength = 0;
+
+            if (!mRegex.GetMatch(&matchStart, &matchLength, index))
+            {
+                continue;
+            }
+
+            // Check if the matched word is actually in the keyword list
+            int keywordId = FindKeyword(comment.wc_str() + matchStart, matchLength);
+            if (keywordId < 0)
+            {
+                // Ignore unknown matches
+                continue;
+            }
+
+            // Ensure we store multiple occurrences but avoid redundant re-processing
+            std::uint64_t& matchedWord = mMatchedKeywords[keywordId / 64];
+            const std::uint64_t matchedBit = std::uint64_t(1) << (keywordId % 64);
+
+            if ((matchedWord & matchedBit) != 0)
+            {
+                continue;
+            }
+
+            matchedWord |= matchedBit;
+
+            if (description.IsEmpty())
+            {
+                description = Decode(mSegment.data(), segmentLength).Trim(false).Trim();
+
+                if (mMaxDescriptionLength > 0 && description.length() > mMaxDescriptionLength)
+                {
+                    description.Truncate(mMaxDescriptionLength);
+                }
+            }
+
+            havGSDFileItem fileItem;
+            fileItem.mType = mKeywordTypes[keywordId];
+            fileItem.mProjectName = fileScan.mProjectName;
+            fileItem.mFileName = fileScan.mFileName;
+            fileItem.mFilePath = fileScan.mFilePath;
+            fileItem.mDescription = description;
+            fileItem.mLine = wxString::Format("%zu", fileScan.mLineNumber);
+
+            fileScan.mFileItems.push_back(std::move(fileItem));
+        }
+    }
+
+    std::vector<wxString> mKeywords;
+    std::vector<wxString> mKeywordTypes;
+    std::size_t mMaxDescriptionLength = 0;
+    wxRegEx mRegex;
+    const std::atomic<bool>* mCancel = nullptr;
+
+    // Scratch buffers, reused for every chunk and file of a scan
+    std::vector<char> mChunk;
+    std::string mSegment;
+    std::vector<wchar_t> mCommentChars;
+    wxString mComment;
+    std::vector<std::uint64_t> mMatchedKeywords;
+};
+
+#endif
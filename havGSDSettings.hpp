@@ -79,11 +79,20 @@ struct havGSDSettingsObject
 {
     std::unordered_map<wxString, havGSDSettingEntry> mSettingEntries;
     bool mShowAbsoluteFilePath;
+    bool mUseScanDaemon;
+    bool mUseGitIndex;
+    int mMaxDescriptionLength;
+    int mCpuBudget;
+    wxString mBaseRef;
 };
 
 class havGSDSettings
 {
 public:
+    static constexpr int DefaultMaxDescriptionLength = 200;
+    static constexpr int DefaultCpuBudget = 100;
+    static constexpr const char* DefaultBaseRef = "origin/HEAD";
+
     havGSDSettings() = default;
     ~havGSDSettings() = default;
 
@@ -91,6 +100,11 @@ public:
     {
         // Reset settings
         mSettingsObject.mShowAbsoluteFilePath = false;
+        mSettingsObject.mUseScanDaemon = false;
+        mSettingsObject.mUseGitIndex = false;
+        mSettingsObject.mMaxDescriptionLength = DefaultMaxDescriptionLength;
+        mSettingsObject.mCpuBudget = DefaultCpuBudget;
+        mSettingsObject.mBaseRef = DefaultBaseRef;
         mSettingsObject.mSettingEntries.clear();
 
         // Create configuration file with default settings, if configuration file doesn't exist
@@ -101,6 +115,11 @@ public:
             JSON root(cJSON_Object);
 
             root.toElement().addProperty("ShowAbsoluteFilePath", false);
+            root.toElement().addProperty("UseScanDaemon", false);
+            root.toElement().addProperty("UseGitIndex", false);
+            root.toElement().addProperty("MaxDescriptionLength", DefaultMaxDescriptionLength);
+            root.toElement().addProperty("CpuBudget", DefaultCpuBudget);
+            root.toElement().addProperty("BaseRef", wxString(DefaultBaseRef));
 
             JSONItem array = root.toElement().AddArray("Entries");
 
@@ -125,6 +144,11 @@ public:
         JSONItem rootItem = root.toElement();
 
         mSettingsObject.mShowAbsoluteFilePath = rootItem["ShowAbsoluteFilePath"].toBool();
+        mSettingsObject.mUseScanDaemon = rootItem["UseScanDaemon"].toBool(false);
+        mSettingsObject.mUseGitIndex = rootItem["UseGitIndex"].toBool(false);
+        mSettingsObject.mMaxDescriptionLength = rootItem["MaxDescriptionLength"].toInt(DefaultMaxDescriptionLength);
+        mSettingsObject.mCpuBudget = rootItem["CpuBudget"].toInt(DefaultCpuBudget);
+        mSettingsObject.mBaseRef = rootItem["BaseRef"].toString(DefaultBaseRef);
 
         int arraySize = rootItem["Entries"].arraySize();
 
@@ -149,6 +173,21 @@ public:
         // "ShowAbsoluteFilePath": false,
         root.toElement().addProperty("ShowAbsoluteFilePath", mSettingsObject.mShowAbsoluteFilePath);
 
+        // "UseScanDaemon": false,
+        root.toElement().addProperty("UseScanDaemon", mSettingsObject.mUseScanDaemon);
+
+        // "UseGitIndex": false,
+        root.toElement().addProperty("UseGitIndex", mSettingsObject.mUseGitIndex);
+
+        // "MaxDescriptionLength": 200,
+        root.toElement().addProperty("MaxDescriptionLength", mSettingsObject.mMaxDescriptionLength);
+
+        // "CpuBudget": 100,
+        root.toElement().addProperty("CpuBudget", mSettingsObject.mCpuBudget);
+
+        // "BaseRef": "origin/HEAD",
+        root.toElement().addProperty("BaseRef", mSettingsObject.mBaseRef);
+
         // "Entries": [
         JSONItem array = root.toElement().AddArray("Entries");
         for (const auto& settingEntry : mSettingsObject.mSettingEntries)
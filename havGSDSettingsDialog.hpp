@@ -45,6 +45,7 @@ SOFTWARE.
 #include <wx/checkbox.h>
 #include <wx/clrpicker.h>
 #include <wx/listctrl.h>
+#include <wx/spinctrl.h>
 #include <wx/string.h>
 #include <wx/textctrl.h>
 #include <wx/wx.h>
@@ -53,6 +54,10 @@ SOFTWARE.
 
 #include "clThemedListCtrl.h"
 
+#include "havGSDProtocol.hpp"
+#include "havGSDScanGovernor.hpp"
+#include "havGSDSettings.hpp"
+
 #ifdef WXC_FROM_DIP
 #undef WXC_FROM_DIP
 #endif
@@ -65,9 +70,9 @@ SOFTWARE.
 class havGSDSettingsDialog : public wxDialog
 {
 public:
-    havGSDSettingsDialog(wxWindow* parent, const std::unordered_map<wxString, wxColour>& defaultKeywordsWithColors, std::unordered_map<wxString, wxColour>& keywordsWithColors, bool& showAbsoluteFilePath)
-        : wxDialog(parent, wxID_ANY, _("havGSD Settings"), wxDefaultPosition, wxSize(400, 400)),
-          mDefaultKeywordsWithColors(defaultKeywordsWithColors), mKeywordsWithColors(keywordsWithColors), mShowAbsoluteFilePath(showAbsoluteFilePath)
+    havGSDSettingsDialog(wxWindow* parent, const std::unordered_map<wxString, wxColour>& defaultKeywordsWithColors, std::unordered_map<wxString, wxColour>& keywordsWithColors, bool& showAbsoluteFilePath, bool& useScanDaemon, bool& useGitIndex, int& maxDescriptionLength, int& cpuBudget, wxString& baseRef)
+        : wxDialog(parent, wxID_ANY, _("havGSD Settings"), wxDefaultPosition, wxDefaultSize, wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER),
+          mDefaultKeywordsWithColors(defaultKeywordsWithColors), mKeywordsWithColors(keywordsWithColors), mShowAbsoluteFilePath(showAbsoluteFilePath), mUseScanDaemon(useScanDaemon), mUseGitIndex(useGitIndex), mMaxDescriptionLength(maxDescriptionLength), mCpuBudget(cpuBudget), mBaseRef(baseRef)
     {
         wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
 
@@ -84,6 +89,7 @@ public:
             AddKeywordToList(keyword, color);
         }
 
+        mKeywordList->SetMinSize(WXC_FROM_DIP(wxSize(400, 150)));
         mainSizer->Add(mKeywordList, 1, wxEXPAND | wxALL, WXC_FROM_DIP(5));
 
         // Add Keyword Input and Color Picker
@@ -108,6 +114,44 @@ public:
         mAbsoluteFilePathCheckbox->SetValue(mShowAbsoluteFilePath);
         mainSizer->Add(mAbsoluteFilePathCheckbox, 0, wxALL | wxALIGN_CENTER_HORIZONTAL, WXC_FROM_DIP(5));
 
+        // Checkbox for Scanning in a Separate Process (Linux and macOS only)
+        mScanDaemonCheckbox = new wxCheckBox(this, wxID_ANY, _("Scan in Separate Process"));
+        mScanDaemonCheckbox->SetValue(mUseScanDaemon);
+#ifndef HAVGSD_HAS_SCAN_DAEMON
+        mScanDaemonCheckbox->Hide();
+#endif
+        mainSizer->Add(mScanDaemonCheckbox, 0, wxALL | wxALIGN_CENTER_HORIZONTAL, WXC_FROM_DIP(5));
+
+        // Checkbox for Rescanning Files changed in the Git Index (Checkouts, Rebases, Pulls)
+        mGitIndexCheckbox = new wxCheckBox(this, wxID_ANY, _("Rescan Files changed in the Git Index"));
+        mGitIndexCheckbox->SetValue(mUseGitIndex);
+        mainSizer->Add(mGitIndexCheckbox, 0, wxALL | wxALIGN_CENTER_HORIZONTAL, WXC_FROM_DIP(5));
+
+        // Maximum Description Length
+        wxBoxSizer* descriptionLengthSizer = new wxBoxSizer(wxHORIZONTAL);
+        descriptionLengthSizer->Add(new wxStaticText(this, wxID_ANY, _("Maximum Description Length:")), 0, wxALL | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+
+        mDescriptionLengthSpin = new wxSpinCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 20, 2000, mMaxDescriptionLength);
+        descriptionLengthSizer->Add(mDescriptionLengthSpin, 0, wxALL | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+        mainSizer->Add(descriptionLengthSizer, 0, wxALIGN_CENTER_HORIZONTAL);
+
+        // CPU Budget of Background Scans, they pause during builds regardless
+        wxBoxSizer* cpuBudgetSizer = new wxBoxSizer(wxHORIZONTAL);
+        cpuBudgetSizer->Add(new wxStaticText(this, wxID_ANY, _("CPU Budget of Background Scans (%):")), 0, wxALL | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+
+        mCpuBudgetSpin = new wxSpinCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, havGSDScanGovernor::MinCpuBudget, havGSDScanGovernor::MaxCpuBudget, mCpuBudget);
+        cpuBudgetSizer->Add(mCpuBudgetSpin, 0, wxALL | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+        mainSizer->Add(cpuBudgetSizer, 0, wxALIGN_CENTER_HORIZONTAL);
+
+        // Git Ref the "New on Branch" Tasks are compared with
+        wxBoxSizer* baseRefSizer = new wxBoxSizer(wxHORIZONTAL);
+        baseRefSizer->Add(new wxStaticText(this, wxID_ANY, _("Base Ref of New Tasks:")), 0, wxALL | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+
+        mBaseRefInput = new wxTextCtrl(this, wxID_ANY, mBaseRef);
+        mBaseRefInput->SetHint(havGSDSettings::DefaultBaseRef);
+        baseRefSizer->Add(mBaseRefInput, 1, wxALL | wxALIGN_CENTER_VERTICAL, WXC_FROM_DIP(5));
+        mainSizer->Add(baseRefSizer, 0, wxEXPAND);
+
         // Restore Default Settings Button
         wxButton* restoreDefaultSettingsBtn = new wxButton(this, wxID_ANY, _("Restore Default Settings"));
         mainSizer->Add(restoreDefaultSettingsBtn, 0, wxEXPAND | wxALL, WXC_FROM_DIP(5));
@@ -120,7 +164,8 @@ public:
         buttonSizer->Add(cancelBtn, 1, wxEXPAND | wxALL, WXC_FROM_DIP(5));
         mainSizer->Add(buttonSizer, 0, wxEXPAND);
 
-        SetSizer(mainSizer);
+        // Size the Dialog to its Controls, the Keyword List keeps a DPI scaled minimum
+        SetSizerAndFit(mainSizer);
 
         // Event Bindings
         addKeywordBtn->Bind(wxEVT_BUTTON, &havGSDSettingsDialog::OnAddKeyword, this);
@@ -170,11 +215,42 @@ public:
         // Reset Show Absolute File Path Option
         mShowAbsoluteFilePath = false;
         mAbsoluteFilePathCheckbox->SetValue(mShowAbsoluteFilePath);
+
+        // Reset Scan in Separate Process Option
+        mUseScanDaemon = false;
+        mScanDaemonCheckbox->SetValue(mUseScanDaemon);
+
+        // Reset Git Index Option
+        mUseGitIndex = false;
+        mGitIndexCheckbox->SetValue(mUseGitIndex);
+
+        // Reset Maximum Description Length
+        mMaxDescriptionLength = havGSDSettings::DefaultMaxDescriptionLength;
+        mDescriptionLengthSpin->SetValue(mMaxDescriptionLength);
+
+        // Reset CPU Budget
+        mCpuBudget = havGSDSettings::DefaultCpuBudget;
+        mCpuBudgetSpin->SetValue(mCpuBudget);
+
+        // Reset Base Ref
+        mBaseRef = havGSDSettings::DefaultBaseRef;
+        mBaseRefInput->SetValue(mBaseRef);
     }
 
     bool TransferDataFromWindow() override
     {
         mShowAbsoluteFilePath = mAbsoluteFilePathCheckbox->GetValue();
+        mUseScanDaemon = mScanDaemonCheckbox->GetValue();
+        mUseGitIndex = mGitIndexCheckbox->GetValue();
+        mMaxDescriptionLength = mDescriptionLengthSpin->GetValue();
+        mCpuBudget = mCpuBudgetSpin->GetValue();
+
+        // An empty ref falls back to the default
+        mBaseRef = mBaseRefInput->GetValue().Trim(true).Trim(false);
+        if (mBaseRef.IsEmpty())
+        {
+            mBaseRef = havGSDSettings::DefaultBaseRef;
+        }
         return true;
     }
 
@@ -183,10 +259,20 @@ private:
     wxTextCtrl* mKeywordInput;
     wxColourPickerCtrl* mColorPicker;
     wxCheckBox* mAbsoluteFilePathCheckbox;
+    wxCheckBox* mScanDaemonCheckbox;
+    wxCheckBox* mGitIndexCheckbox;
+    wxSpinCtrl* mDescriptionLengthSpin;
+    wxSpinCtrl* mCpuBudgetSpin;
+    wxTextCtrl* mBaseRefInput;
 
     std::unordered_map<wxString, wxColour> mDefaultKeywordsWithColors;
     std::unordered_map<wxString, wxColour>& mKeywordsWithColors;
     bool& mShowAbsoluteFilePath;
+    bool& mUseScanDaemon;
+    bool& mUseGitIndex;
+    int& mMaxDescriptionLength;
+    int& mCpuBudget;
+    wxString& mBaseRef;
 
     wxBorder get_border_simple_theme_aware_bit()
     {
@@ -0,0 +1,84 @@
+/*
+havGSDSnapshot.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDSNAPSHOT_HPP
+#define HAVGSDSNAPSHOT_HPP
+
+#include <atomic>
+#include <memory>
+
+// Publishes immutable, reference-counted snapshots (RCU-style)
+// - The writer builds a new object and swaps it in atomically, it never waits for readers
+// - Readers acquire the current snapshot and keep it alive as long as they need it
+// - A replaced snapshot is freed when its last reader drops it
+// - Swapping and acquiring the pointer isn't lock-free, the standard libraries guard it with a short spinlock or mutex,
+//   but it is held only while the reference count changes, never while a snapshot is built or read
+template <typename T>
+class havGSDSnapshotPublisher
+{
+public:
+    using Snapshot = std::shared_ptr<const T>;
+
+    havGSDSnapshotPublisher() : mSnapshot(std::make_shared<const T>()) {}
+    ~havGSDSnapshotPublisher() = default;
+
+    havGSDSnapshotPublisher(const havGSDSnapshotPublisher&) = delete;
+    havGSDSnapshotPublisher& operator=(const havGSDSnapshotPublisher&) = delete;
+
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+    Snapshot Acquire() const { return mSnapshot.load(); }
+
+    void Publish(Snapshot snapshot) { mSnapshot.store(std::move(snapshot)); }
+
+private:
+    std::atomic<Snapshot> mSnapshot;
+#else
+    // The free functions are deprecated in C++20 in favour of std::atomic<std::shared_ptr>
+    Snapshot Acquire() const { return std::atomic_load(&mSnapshot); }
+
+    void Publish(Snapshot snapshot) { std::atomic_store(&mSnapshot, std::move(snapshot)); }
+
+private:
+    Snapshot mSnapshot;
+#endif
+};
+
+#endif
@@ -0,0 +1,105 @@
+/*
+havGSDTaskCounters.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDTASKCOUNTERS_HPP
+#define HAVGSDTASKCOUNTERS_HPP
+
+#include <wx/string.h>
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "havGSDScanner.hpp"
+
+// Number of tasks per keyword and per file, kept up to date as results are added and replaced instead of recounted
+class havGSDTaskCounters
+{
+public:
+    using Counts = std::map<wxString, std::size_t>;
+
+    void Add(const havGSDFileItem& fileItem)
+    {
+        ++mTypeCounts[fileItem.mType];
+        ++mFileCounts[fileItem.mFilePath];
+        ++mTotal;
+    }
+
+    void Add(const std::vector<havGSDFileItem>& fileItems, std::size_t first, std::size_t last)
+    {
+        for (std::size_t index = first; index < last; ++index)
+        {
+            Add(fileItems[index]);
+        }
+    }
+
+    void Remove(const havGSDFileItem& fileItem)
+    {
+        Decrement(mTypeCounts, fileItem.mType);
+        Decrement(mFileCounts, fileItem.mFilePath);
+        --mTotal;
+    }
+
+    std::size_t GetTotal() const { return mTotal; }
+
+    // Sorted by keyword
+    const Counts& GetTypeCounts() const { return mTypeCounts; }
+
+    // Sorted by file path, only files with tasks
+    const Counts& GetFileCounts() const { return mFileCounts; }
+
+private:
+    static void Decrement(Counts& counts, const wxString& key)
+    {
+        auto foundCount = counts.find(key);
+
+        if (foundCount != counts.end() && --foundCount->second == 0)
+        {
+            counts.erase(foundCount);
+        }
+    }
+
+    std::size_t mTotal = 0;
+    Counts mTypeCounts;
+    Counts mFileCounts;
+};
+
+#endif
@@ -0,0 +1,497 @@
+/*
+havGSDTaskIndex.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDTASKINDEX_HPP
+#define HAVGSDTASKINDEX_HPP
+
+#include <wx/string.h>
+#include <wx/tokenzr.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include "havGSDScanner.hpp"
+
+// Search index over the items of a scan, built on the scan thread together with the results
+// Filter syntax (case-insensitive, terms separated by spaces):
+// - type:<text>, file:<text>, project:<text>, owner:<text> match items whose field contains the text, owner is the name in TODO(name)
+// - Any other term matches items whose description contains it
+// - Terms of the same field are combined with OR, everything else with AND
+class havGSDTaskIndex
+{
+public:
+    using ItemIds = std::vector<std::uint32_t>;
+
+    // Item ID in the list passed to Update() of items which aren't in the base index
+    static constexpr std::uint32_t NewItemId = 0xFFFFFFFF;
+
+    void Build(const std::vector<havGSDFileItem>& fileItems)
+    {
+        mItemCount = static_cast<std::uint32_t>(fileItems.size());
+        mDescriptions.clear();
+        mDescriptions.reserve(fileItems.size());
+        mTrigrams.clear();
+        mTypes.clear();
+        mProjects.clear();
+        mFiles.clear();
+        mFileIndices.clear();
+        mOwners.clear();
+
+        for (std::uint32_t itemId = 0; itemId < mItemCount; ++itemId)
+        {
+            AddItem(itemId, fileItems[itemId], nullptr);
+        }
+    }
+
+    // Builds the index of items which mostly come from the items of the base index, like the results of a rescan
+    // - baseItemIds holds the ID in the base index of each item, or NewItemId, the items of the base keep their order
+    // - The lists of the base are renumbered, only the new items are lowercased and split into trigrams
+    void Update(const havGSDTaskIndex& base, const std::vector<havGSDFileItem>& fileItems, const ItemIds& baseItemIds)
+    {
+        mItemCount = static_cast<std::uint32_t>(fileItems.size());
+        mTrigrams = base.mTrigrams;
+        mTypes = base.mTypes;
+        mProjects = base.mProjects;
+        mFiles = base.mFiles;
+        mFileIndices = base.mFileIndices;
+        mOwners = base.mOwners;
+
+        ItemIds newItemIds(base.mItemCount, NewItemId);
+        std::size_t newItemCount = 0;
+
+        for (std::uint32_t itemId = 0; itemId < mItemCount; ++itemId)
+        {
+            if (baseItemIds[itemId] == NewItemId)
+            {
+                ++newItemCount;
+            }
+            else
+            {
+                newItemIds[baseItemIds[itemId]] = itemId;
+            }
+        }
+
+        Renumber(mTrigrams, newItemIds);
+        Renumber(mTypes, newItemIds);
+        Renumber(mProjects, newItemIds);
+        Renumber(mOwners, newItemIds);
+        RenumberFiles(newItemIds);
+
+        // The lists of new files are added to mFiles, it mustn't move while AddItem() remembers the lists it changed
+        mFiles.reserve(mFiles.size() + newItemCount);
+
+        mDescriptions.clear();
+        mDescriptions.reserve(fileItems.size());
+
+        std::unordered_map<ItemIds*, std::size_t> changedItemIds;
+
+        for (std::uint32_t itemId = 0; itemId < mItemCount; ++itemId)
+        {
+            if (baseItemIds[itemId] == NewItemId)
+            {
+                AddItem(itemId, fileItems[itemId], &changedItemIds);
+            }
+            else
+            {
+                mDescriptions.push_back(base.mDescriptions[baseItemIds[itemId]]);
+            }
+        }
+
+        // The new items were added behind items with higher IDs, both parts are sorted
+        for (auto& [itemIds, addedIndex] : changedItemIds)
+        {
+            std::inplace_merge(itemIds->begin(), itemIds->begin() + addedIndex, itemIds->end());
+        }
+    }
+
+    // Returns the IDs of the matching items in ascending order
+    ItemIds Query(const wxString& filter) const
+    {
+        std::vector<wxString> types;
+        std::vector<wxString> files;
+        std::vector<wxString> projects;
+        std::vector<wxString> owners;
+        std::vector<wxString> texts;
+
+        wxStringTokenizer tokenizer(filter.Lower(), " \t", wxTOKEN_STRTOK);
+        while (tokenizer.HasMoreTokens())
+        {
+            wxString token = tokenizer.GetNextToken();
+            wxString value;
+
+            if (token.StartsWith("type:", &value))
+            {
+                AddTerm(types, value);
+            }
+            else if (token.StartsWith("file:", &value))
+            {
+                AddTerm(files, value);
+            }
+            else if (token.StartsWith("project:", &value))
+            {
+                AddTerm(projects, value);
+            }
+            else if (token.StartsWith("owner:", &value))
+            {
+                AddTerm(owners, value);
+            }
+            else
+            {
+                AddTerm(texts, token);
+            }
+        }
+
+        bool hasCandidates = false;
+        ItemIds candidates;
+
+        // Fields with few distinct values, match the terms against the values
+        RestrictToField(mTypes, types, hasCandidates, candidates);
+        RestrictToField(mProjects, projects, hasCandidates, candidates);
+        RestrictToField(mFiles, files, hasCandidates, candidates);
+        RestrictToField(mOwners, owners, hasCandidates, candidates);
+
+        // Descriptions, narrow down through the trigrams of the terms before comparing the text
+        std::vector<const ItemIds*> trigramItemIds;
+
+        for (const auto& text : texts)
+        {
+            for (std::size_t index = 0; index + 3 <= text.length(); ++index)
+            {
+                auto foundTrigram = mTrigrams.find(MakeTrigram(text.wc_str() + index));
+                if (foundTrigram == mTrigrams.end())
+                {
+                    return ItemIds();
+                }
+
+                // Trigrams which occur in every item don't narrow anything down
+                if (foundTrigram->second.size() < mItemCount)
+                {
+                    trigramItemIds.push_back(&foundTrigram->second);
+                }
+            }
+        }
+
+        // Rarest trigrams first, stop once only a few candidates are left to compare
+        std::sort(trigramItemIds.begin(), trigramItemIds.end(),
+            [](const ItemIds* left, const ItemIds* right) { return left->size() < right->size(); });
+
+        for (const ItemIds* itemIds : trigramItemIds)
+        {
+            if (hasCandidates && candidates.size() <= 32)
+            {
+                break;
+            }
+
+            Intersect(hasCandidates, candidates, *itemIds);
+        }
+
+        if (!hasCandidates)
+        {
+            AllItemIds(candidates);
+        }
+
+        if (!texts.empty())
+        {
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                [&](std::uint32_t itemId) {
+                    const wxString& description = mDescriptions[itemId];
+                    return std::any_of(texts.begin(), texts.end(),
+                        [&](const wxString& text) { return description.find(text) == wxString::npos; });
+                }),
+                candidates.end());
+        }
+
+        return candidates;
+    }
+
+    // Returns the IDs of the items with exactly the keyword and file in ascending order, an empty keyword or file matches any
+    // The file is compared case-sensitively like the groups of havGSDTaskCounters, only the file: filter ignores case
+    ItemIds Find(const wxString& type, const wxString& filePath) const
+    {
+        bool hasCandidates = false;
+        ItemIds candidates;
+
+        if (!type.IsEmpty())
+        {
+            auto foundType = mTypes.find(type.Lower());
+            if (foundType == mTypes.end())
+            {
+                return ItemIds();
+            }
+
+            Intersect(hasCandidates, candidates, foundType->second);
+        }
+
+        if (!filePath.IsEmpty())
+        {
+            auto foundFile = mFileIndices.find(filePath);
+            if (foundFile == mFileIndices.end())
+            {
+                return ItemIds();
+            }
+
+            Intersect(hasCandidates, candidates, mFiles[foundFile->second].second);
+        }
+
+        if (!hasCandidates)
+        {
+            AllItemIds(candidates);
+        }
+
+        return candidates;
+    }
+
+    // Returns the name in "TODO(name)", expects lowercase input
+    static wxString ParseOwner(const wxString& description, const wxString& type)
+    {
+        std::size_t start = description.find(type + "(");
+        if (start == wxString::npos)
+        {
+            return wxString();
+        }
+
+        start += type.length() + 1;
+
+        std::size_t end = description.find(')', start);
+        if (end == wxString::npos)
+        {
+            return wxString();
+        }
+
+        return description.Mid(start, end - start).Trim(false).Trim();
+    }
+
+private:
+    // Adds the item behind the items with lower IDs, the index of the first added ID of each changed list is kept in changedItemIds
+    void AddItem(std::uint32_t itemId, const havGSDFileItem& fileItem, std::unordered_map<ItemIds*, std::size_t>* changedItemIds)
+    {
+        auto addItemId = [&](ItemIds& itemIds) {
+            if (changedItemIds)
+            {
+                changedItemIds->emplace(&itemIds, itemIds.size());
+            }
+
+            AddItemId(itemIds, itemId);
+        };
+
+        mDescriptions.push_back(fileItem.mDescription.Lower());
+        const wxString& description = mDescriptions.back();
+
+        const wxString type = fileItem.mType.Lower();
+
+        addItemId(mTypes[type]);
+        addItemId(mProjects[fileItem.mProjectName.Lower()]);
+
+        auto foundFile = mFileIndices.find(fileItem.mFilePath);
+        if (foundFile == mFileIndices.end())
+        {
+            foundFile = mFileIndices.emplace(fileItem.mFilePath, mFiles.size()).first;
+            mFiles.emplace_back(fileItem.mFilePath.Lower(), ItemIds());
+        }
+        addItemId(mFiles[foundFile->second].second);
+
+        const wxString owner = ParseOwner(description, type);
+        if (!owner.IsEmpty())
+        {
+            addItemId(mOwners[owner]);
+        }
+
+        for (std::size_t index = 0; index + 3 <= description.length(); ++index)
+        {
+            addItemId(mTrigrams[MakeTrigram(description.wc_str() + index)]);
+        }
+    }
+
+    // Replaces the IDs of the items by their new IDs and drops the removed items, the order of the items doesn't change
+    static void Renumber(ItemIds& itemIds, const ItemIds& newItemIds)
+    {
+        auto lastItemId = itemIds.begin();
+
+        for (std::uint32_t itemId : itemIds)
+        {
+            if (newItemIds[itemId] != NewItemId)
+            {
+                *lastItemId++ = newItemIds[itemId];
+            }
+        }
+
+        itemIds.erase(lastItemId, itemIds.end());
+    }
+
+    template <typename Key>
+    static void Renumber(std::unordered_map<Key, ItemIds>& fieldIndex, const ItemIds& newItemIds)
+    {
+        for (auto value = fieldIndex.begin(); value != fieldIndex.end();)
+        {
+            Renumber(value->second, newItemIds);
+            value = value->second.empty() ? fieldIndex.erase(value) : std::next(value);
+        }
+    }
+
+    // Files without items left are removed, which moves the files behind them
+    void RenumberFiles(const ItemIds& newItemIds)
+    {
+        std::vector<std::size_t> fileIndices(mFiles.size());
+        std::size_t fileCount = 0;
+
+        for (std::size_t fileIndex = 0; fileIndex < mFiles.size(); ++fileIndex)
+        {
+            Renumber(mFiles[fileIndex].second, newItemIds);
+
+            if (mFiles[fileIndex].second.empty())
+            {
+                fileIndices[fileIndex] = mFiles.size();
+                continue;
+            }
+
+            if (fileCount != fileIndex)
+            {
+                mFiles[fileCount] = std::move(mFiles[fileIndex]);
+            }
+
+            fileIndices[fileIndex] = fileCount++;
+        }
+
+        for (auto foundFile = mFileIndices.begin(); foundFile != mFileIndices.end();)
+        {
+            foundFile->second = fileIndices[foundFile->second];
+            foundFile = (foundFile->second == mFiles.size()) ? mFileIndices.erase(foundFile) : std::next(foundFile);
+        }
+
+        mFiles.resize(fileCount);
+    }
+
+    static std::uint64_t MakeTrigram(const wxChar* text)
+    {
+        return (static_cast<std::uint64_t>(text[0] & 0x1FFFFF) << 42) |
+               (static_cast<std::uint64_t>(text[1] & 0x1FFFFF) << 21) |
+               static_cast<std::uint64_t>(text[2] & 0x1FFFFF);
+    }
+
+    // Item IDs are added in ascending order, so the lists stay sorted
+    static void AddItemId(ItemIds& itemIds, std::uint32_t itemId)
+    {
+        if (itemIds.empty() || itemIds.back() != itemId)
+        {
+            itemIds.push_back(itemId);
+        }
+    }
+
+    static void AddTerm(std::vector<wxString>& terms, const wxString& term)
+    {
+        if (!term.IsEmpty())
+        {
+            terms.push_back(term);
+        }
+    }
+
+    void AllItemIds(ItemIds& itemIds) const
+    {
+        itemIds.resize(mItemCount);
+
+        for (std::uint32_t itemId = 0; itemId < mItemCount; ++itemId)
+        {
+            itemIds[itemId] = itemId;
+        }
+    }
+
+    static void Intersect(bool& hasCandidates, ItemIds& candidates, const ItemIds& itemIds)
+    {
+        if (!hasCandidates)
+        {
+            candidates = itemIds;
+            hasCandidates = true;
+            return;
+        }
+
+        ItemIds intersection;
+        std::set_intersection(candidates.begin(), candidates.end(), itemIds.begin(), itemIds.end(), std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    // Keeps the candidates which have a value containing any of the terms
+    template <typename FieldIndex>
+    static void RestrictToField(const FieldIndex& fieldIndex, const std::vector<wxString>& terms, bool& hasCandidates, ItemIds& candidates)
+    {
+        if (terms.empty())
+        {
+            return;
+        }
+
+        ItemIds matches;
+        std::size_t matchedValueCount = 0;
+
+        for (const auto& [value, itemIds] : fieldIndex)
+        {
+            bool matched = std::any_of(terms.begin(), terms.end(),
+                [&](const wxString& term) { return value.find(term) != wxString::npos; });
+
+            if (matched)
+            {
+                matches.insert(matches.end(), itemIds.begin(), itemIds.end());
+                ++matchedValueCount;
+            }
+        }
+
+        // The item IDs of a single value are already sorted and unique
+        if (matchedValueCount > 1)
+        {
+            std::sort(matches.begin(), matches.end());
+            matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+        }
+
+        Intersect(hasCandidates, candidates, matches);
+    }
+
+    std::uint32_t mItemCount = 0;
+    std::vector<wxString> mDescriptions; // Lowercase
+    std::unordered_map<std::uint64_t, ItemIds> mTrigrams;
+    std::unordered_map<wxString, ItemIds> mTypes;
+    std::unordered_map<wxString, ItemIds> mProjects;
+    std::vector<std::pair<wxString, ItemIds>> mFiles; // Lowercase, for the file: filter
+    std::unordered_map<wxString, std::size_t> mFileIndices; // Exact path to index into mFiles
+    std::unordered_map<wxString, ItemIds> mOwners;
+};
+
+#endif
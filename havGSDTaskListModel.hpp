@@ -0,0 +1,234 @@
+/*
+havGSDTaskListModel.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDTASKLISTMODEL_HPP
+#define HAVGSDTASKLISTMODEL_HPP
+
+#include <wx/colour.h>
+#include <wx/dataview.h>
+#include <wx/filename.h>
+#include <wx/intl.h>
+#include <wx/string.h>
+#include <wx/variant.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "havGSDScanner.hpp"
+
+// Group row of the task list, an empty keyword or file matches any
+struct havGSDTaskGroup
+{
+    wxString mType;
+    wxString mFilePath;
+    std::size_t mCount = 0;
+    bool mExpanded = false;
+
+    wxString GetKey() const { return mType + "\n" + mFilePath; }
+};
+
+// Row of the task list, either a task or a group
+struct havGSDTaskRow
+{
+    std::uint32_t mItemId;
+    std::int32_t mGroupIndex; // Index into the groups, -1 for tasks
+};
+
+// Rows of the task list, the list control only asks for the text of the rows it shows
+// - Rows refer to tasks by their index in the displayed results, so filtering and sorting only rebuild a vector of IDs
+// - The rows and groups are built by the plugin, Update() tells the list control about them
+class havGSDTaskListModel : public wxDataViewVirtualListModel
+{
+public:
+    // Same order as the headers
+    enum Column
+    {
+        TypeColumn,
+        DescriptionColumn,
+        ProjectColumn,
+        FileColumn,
+        LineColumn
+    };
+
+    havGSDTaskListModel() = default;
+    ~havGSDTaskListModel() = default;
+
+    // Results the rows refer to, they must stay alive until the next call
+    void SetFileItems(const std::vector<havGSDFileItem>* fileItems) { mFileItems = fileItems; }
+
+    void SetShowAbsoluteFilePath(bool showAbsoluteFilePath) { mShowAbsoluteFilePath = showAbsoluteFilePath; }
+
+    // Keywords without a color use the default text color
+    void SetTypeColours(std::unordered_map<wxString, wxColour> typeColours) { mTypeColours = std::move(typeColours); }
+
+    void Clear()
+    {
+        mRows.clear();
+        mGroups.clear();
+    }
+
+    void AppendTask(std::uint32_t itemId) { mRows.push_back({ itemId, -1 }); }
+
+    void AppendGroup(havGSDTaskGroup group)
+    {
+        mGroups.push_back(std::move(group));
+        mRows.push_back({ 0, static_cast<std::int32_t>(mGroups.size() - 1) });
+    }
+
+    void Update() { Reset(static_cast<unsigned int>(mRows.size())); }
+
+    std::size_t GetRowCount() const { return mRows.size(); }
+
+    const havGSDTaskRow& GetTaskRow(std::size_t row) const { return mRows[row]; }
+
+    const havGSDTaskGroup& GetGroup(std::int32_t groupIndex) const { return mGroups[groupIndex]; }
+
+    void GetValueByRow(wxVariant& variant, unsigned int row, unsigned int column) const override
+    {
+        variant = GetText(row, column);
+    }
+
+    bool SetValueByRow(const wxVariant& variant, unsigned int row, unsigned int column) override
+    {
+        // The list is read only
+        wxUnusedVar(variant);
+        wxUnusedVar(row);
+        wxUnusedVar(column);
+        return false;
+    }
+
+    bool GetAttrByRow(unsigned int row, unsigned int column, wxDataViewItemAttr& attr) const override
+    {
+        if (column != TypeColumn || row >= mRows.size())
+        {
+            return false;
+        }
+
+        const havGSDTaskRow& taskRow = mRows[row];
+        const wxString& type = (taskRow.mGroupIndex >= 0) ? mGroups[taskRow.mGroupIndex].mType : (*mFileItems)[taskRow.mItemId].mType;
+
+        auto foundTypeColour = mTypeColours.find(type);
+        if (foundTypeColour == mTypeColours.end())
+        {
+            return false;
+        }
+
+        attr.SetColour(foundTypeColour->second);
+        return true;
+    }
+
+private:
+    wxString GetText(unsigned int row, unsigned int column) const
+    {
+        if (row >= mRows.size())
+        {
+            return wxString();
+        }
+
+        const havGSDTaskRow& taskRow = mRows[row];
+
+        if (taskRow.mGroupIndex >= 0)
+        {
+            return GetGroupText(mGroups[taskRow.mGroupIndex], column);
+        }
+
+        const havGSDFileItem& fileItem = (*mFileItems)[taskRow.mItemId];
+
+        switch (column)
+        {
+        case TypeColumn:
+            return fileItem.mType;
+        case DescriptionColumn:
+            return fileItem.mDescription;
+        case ProjectColumn:
+            return fileItem.mProjectName;
+        case FileColumn:
+            return mShowAbsoluteFilePath ? fileItem.mFilePath : fileItem.mFileName;
+        case LineColumn:
+            return fileItem.mLine;
+        default:
+            return wxString();
+        }
+    }
+
+    wxString GetGroupText(const havGSDTaskGroup& group, unsigned int column) const
+    {
+        switch (column)
+        {
+        case TypeColumn:
+        {
+            wxString groupName = group.mExpanded ? "[-] " : "[+] ";
+
+            if (group.mFilePath.IsEmpty())
+            {
+                groupName += group.mType;
+            }
+            else if (!group.mType.IsEmpty())
+            {
+                // Files of a keyword are indented below it
+                groupName.Prepend("    ");
+            }
+
+            return groupName;
+        }
+        case DescriptionColumn:
+            return wxString::Format(wxPLURAL("%zu task", "%zu tasks", group.mCount), group.mCount);
+        case FileColumn:
+            if (group.mFilePath.IsEmpty())
+            {
+                return wxString();
+            }
+
+            return mShowAbsoluteFilePath ? group.mFilePath : wxFileName(group.mFilePath).GetFullName();
+        default:
+            return wxString();
+        }
+    }
+
+    const std::vector<havGSDFileItem>* mFileItems = nullptr;
+    std::vector<havGSDTaskRow> mRows;
+    std::vector<havGSDTaskGroup> mGroups;
+    std::unordered_map<wxString, wxColour> mTypeColours;
+    bool mShowAbsoluteFilePath = false;
+};
+
+#endif
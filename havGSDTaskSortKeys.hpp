@@ -0,0 +1,340 @@
+/*
+havGSDTaskSortKeys.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDTASKSORTKEYS_HPP
+#define HAVGSDTASKSORTKEYS_HPP
+
+#include <wx/string.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "havGSDScanner.hpp"
+
+enum class havGSDSortColumn
+{
+    Type,
+    Project,
+    FileName,
+    FilePath,
+    Line
+};
+
+struct havGSDSortKey
+{
+    havGSDSortColumn mColumn;
+    bool mAscending;
+};
+
+// Integer sort keys of the items of a scan, built on the scan thread together with the results
+// - Strings are replaced by their rank among the distinct values of the column, so sorting never compares strings
+// - The keys of a sort are packed into one integer where they fit, the item ID breaks ties, which keeps the sort stable
+class havGSDTaskSortKeys
+{
+public:
+    using ItemIds = std::vector<std::uint32_t>;
+
+    void Build(const std::vector<havGSDFileItem>& fileItems)
+    {
+        BuildRanks(fileItems, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mType; }, havGSDSortColumn::Type);
+        BuildRanks(fileItems, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mProjectName; }, havGSDSortColumn::Project);
+        BuildRanks(fileItems, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mFileName; }, havGSDSortColumn::FileName);
+        BuildRanks(fileItems, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mFilePath; }, havGSDSortColumn::FilePath);
+
+        std::vector<std::uint32_t>& lines = GetKeys(havGSDSortColumn::Line);
+        std::uint32_t& maxLine = GetMaxKey(havGSDSortColumn::Line);
+
+        lines.resize(fileItems.size());
+        maxLine = 0;
+
+        for (std::size_t index = 0; index < fileItems.size(); ++index)
+        {
+            lines[index] = ParseLine(fileItems[index]);
+            maxLine = std::max(maxLine, lines[index]);
+        }
+    }
+
+    // Builds the keys of items which mostly come from the items of the base keys, like the results of a rescan
+    // - baseItemIds holds the ID in the base of each item, or an ID beyond the base items for new items
+    // - The keys of the base are only renumbered when new values take ranks between them, the ranks of values without items are kept
+    void Update(const havGSDTaskSortKeys& base, const std::vector<havGSDFileItem>& fileItems, const ItemIds& baseItemIds)
+    {
+        UpdateRanks(base, fileItems, baseItemIds, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mType; }, havGSDSortColumn::Type);
+        UpdateRanks(base, fileItems, baseItemIds, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mProjectName; }, havGSDSortColumn::Project);
+        UpdateRanks(base, fileItems, baseItemIds, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mFileName; }, havGSDSortColumn::FileName);
+        UpdateRanks(base, fileItems, baseItemIds, [](const havGSDFileItem& fileItem) -> const wxString& { return fileItem.mFilePath; }, havGSDSortColumn::FilePath);
+
+        const std::vector<std::uint32_t>& baseLines = base.mKeys[static_cast<std::size_t>(havGSDSortColumn::Line)];
+        std::vector<std::uint32_t>& lines = GetKeys(havGSDSortColumn::Line);
+        std::uint32_t& maxLine = GetMaxKey(havGSDSortColumn::Line);
+
+        lines.resize(fileItems.size());
+        maxLine = base.GetMaxKey(havGSDSortColumn::Line);
+
+        for (std::size_t index = 0; index < fileItems.size(); ++index)
+        {
+            if (baseItemIds[index] < baseLines.size())
+            {
+                lines[index] = baseLines[baseItemIds[index]];
+                continue;
+            }
+
+            lines[index] = ParseLine(fileItems[index]);
+            maxLine = std::max(maxLine, lines[index]);
+        }
+    }
+
+    // Sorts the item IDs by the sort keys, the first key is the primary one, equal items keep their order
+    void Sort(ItemIds& itemIds, const std::vector<havGSDSortKey>& sortKeys) const
+    {
+        if (sortKeys.empty() || itemIds.size() < 2)
+        {
+            return;
+        }
+
+        unsigned int keyBits = 0;
+
+        for (const auto& sortKey : sortKeys)
+        {
+            keyBits += GetBitWidth(GetMaxKey(sortKey.mColumn));
+        }
+
+        if (keyBits > 64)
+        {
+            std::stable_sort(itemIds.begin(), itemIds.end(),
+                [&](std::uint32_t left, std::uint32_t right) {
+                    for (const auto& sortKey : sortKeys)
+                    {
+                        const std::uint32_t leftKey = GetKey(sortKey, left);
+                        const std::uint32_t rightKey = GetKey(sortKey, right);
+
+                        if (leftKey != rightKey)
+                        {
+                            return leftKey < rightKey;
+                        }
+                    }
+
+                    return false;
+                });
+
+            return;
+        }
+
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> packedKeys;
+        packedKeys.reserve(itemIds.size());
+
+        for (std::uint32_t itemId : itemIds)
+        {
+            std::uint64_t packedKey = 0;
+
+            for (const auto& sortKey : sortKeys)
+            {
+                packedKey = (packedKey << GetBitWidth(GetMaxKey(sortKey.mColumn))) | GetKey(sortKey, itemId);
+            }
+
+            packedKeys.emplace_back(packedKey, itemId);
+        }
+
+        std::sort(packedKeys.begin(), packedKeys.end());
+
+        for (std::size_t index = 0; index < itemIds.size(); ++index)
+        {
+            itemIds[index] = packedKeys[index].second;
+        }
+    }
+
+private:
+    static constexpr std::size_t ColumnCount = 5;
+
+    std::vector<std::uint32_t>& GetKeys(havGSDSortColumn column) { return mKeys[static_cast<std::size_t>(column)]; }
+    std::vector<wxString>& GetValues(havGSDSortColumn column) { return mValues[static_cast<std::size_t>(column)]; }
+    std::uint32_t& GetMaxKey(havGSDSortColumn column) { return mMaxKeys[static_cast<std::size_t>(column)]; }
+    std::uint32_t GetMaxKey(havGSDSortColumn column) const { return mMaxKeys[static_cast<std::size_t>(column)]; }
+
+    // Descending keys are mirrored, so every sort is ascending
+    std::uint32_t GetKey(const havGSDSortKey& sortKey, std::uint32_t itemId) const
+    {
+        const std::uint32_t key = mKeys[static_cast<std::size_t>(sortKey.mColumn)][itemId];
+        return sortKey.mAscending ? key : GetMaxKey(sortKey.mColumn) - key;
+    }
+
+    static std::uint32_t ParseLine(const havGSDFileItem& fileItem)
+    {
+        return static_cast<std::uint32_t>(std::wcstoul(fileItem.mLine.wc_str(), nullptr, 10));
+    }
+
+    // Order of the ranks, case-insensitive with the case deciding between otherwise equal values
+    static bool IsRankedBefore(const wxString& left, const wxString& right)
+    {
+        const int result = left.CmpNoCase(right);
+        return (result != 0) ? (result < 0) : (left < right);
+    }
+
+    static unsigned int GetBitWidth(std::uint32_t value)
+    {
+        unsigned int bitWidth = 0;
+
+        while (value != 0)
+        {
+            ++bitWidth;
+            value >>= 1;
+        }
+
+        return bitWidth;
+    }
+
+    // Interns the values of a column and replaces the IDs by the rank of the value, sorted case-insensitively
+    template <typename GetValue>
+    void BuildRanks(const std::vector<havGSDFileItem>& fileItems, GetValue getValue, havGSDSortColumn column)
+    {
+        std::vector<std::uint32_t>& keys = GetKeys(column);
+        keys.resize(fileItems.size());
+
+        std::unordered_map<wxString, std::uint32_t> valueIds;
+        std::vector<const wxString*> values;
+
+        for (std::size_t index = 0; index < fileItems.size(); ++index)
+        {
+            auto [foundValue, inserted] = valueIds.emplace(getValue(fileItems[index]), static_cast<std::uint32_t>(values.size()));
+            if (inserted)
+            {
+                values.push_back(&foundValue->first);
+            }
+
+            keys[index] = foundValue->second;
+        }
+
+        std::vector<std::uint32_t> order(values.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        std::sort(order.begin(), order.end(),
+            [&](std::uint32_t left, std::uint32_t right) { return IsRankedBefore(*values[left], *values[right]); });
+
+        std::vector<std::uint32_t> ranks(values.size());
+        std::vector<wxString>& rankedValues = GetValues(column);
+
+        rankedValues.clear();
+        rankedValues.reserve(values.size());
+
+        for (std::size_t rank = 0; rank < order.size(); ++rank)
+        {
+            ranks[order[rank]] = static_cast<std::uint32_t>(rank);
+            rankedValues.push_back(*values[order[rank]]);
+        }
+
+        for (auto& key : keys)
+        {
+            key = ranks[key];
+        }
+
+        GetMaxKey(column) = values.empty() ? 0 : static_cast<std::uint32_t>(values.size() - 1);
+    }
+
+    // Ranks the values of the new items among the values of the base, new values are merged in and move the ranks behind them
+    template <typename GetValue>
+    void UpdateRanks(const havGSDTaskSortKeys& base, const std::vector<havGSDFileItem>& fileItems, const ItemIds& baseItemIds, GetValue getValue, havGSDSortColumn column)
+    {
+        const std::vector<std::uint32_t>& baseKeys = base.mKeys[static_cast<std::size_t>(column)];
+        const std::vector<wxString>& baseValues = base.mValues[static_cast<std::size_t>(column)];
+
+        std::vector<wxString> addedValues;
+
+        for (std::size_t index = 0; index < fileItems.size(); ++index)
+        {
+            if (baseItemIds[index] >= baseKeys.size() && !std::binary_search(baseValues.begin(), baseValues.end(), getValue(fileItems[index]), IsRankedBefore))
+            {
+                addedValues.push_back(getValue(fileItems[index]));
+            }
+        }
+
+        std::sort(addedValues.begin(), addedValues.end(), IsRankedBefore);
+        addedValues.erase(std::unique(addedValues.begin(), addedValues.end()), addedValues.end());
+
+        std::vector<wxString>& values = GetValues(column);
+        std::vector<std::uint32_t> ranks(baseValues.size());
+
+        values.clear();
+        values.reserve(baseValues.size() + addedValues.size());
+
+        auto addedValue = addedValues.begin();
+
+        for (std::size_t baseRank = 0; baseRank < baseValues.size(); ++baseRank)
+        {
+            while (addedValue != addedValues.end() && IsRankedBefore(*addedValue, baseValues[baseRank]))
+            {
+                values.push_back(*addedValue++);
+            }
+
+            ranks[baseRank] = static_cast<std::uint32_t>(values.size());
+            values.push_back(baseValues[baseRank]);
+        }
+
+        values.insert(values.end(), addedValue, addedValues.end());
+
+        std::vector<std::uint32_t>& keys = GetKeys(column);
+        keys.resize(fileItems.size());
+
+        for (std::size_t index = 0; index < fileItems.size(); ++index)
+        {
+            if (baseItemIds[index] < baseKeys.size())
+            {
+                keys[index] = ranks[baseKeys[baseItemIds[index]]];
+                continue;
+            }
+
+            keys[index] = static_cast<std::uint32_t>(std::lower_bound(values.begin(), values.end(), getValue(fileItems[index]), IsRankedBefore) - values.begin());
+        }
+
+        GetMaxKey(column) = values.empty() ? 0 : static_cast<std::uint32_t>(values.size() - 1);
+    }
+
+    std::array<std::vector<std::uint32_t>, ColumnCount> mKeys;
+    std::array<std::vector<wxString>, ColumnCount> mValues; // Values of the string columns in the order of their ranks
+    std::array<std::uint32_t, ColumnCount> mMaxKeys{};
+};
+
+#endif
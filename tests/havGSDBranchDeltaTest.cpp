@@ -0,0 +1,357 @@
+/*
+havGSDBranchDeltaTest.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "havGSDBranchDelta.hpp"
+#include "havGSDGitFixture.hpp"
+#include "havGSDTest.hpp"
+
+#include <wx/init.h>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <vector>
+
+// Work tree with the files of a base commit on "main" and their current content
+class havGSDBranchFixture
+{
+public:
+    havGSDBranchFixture() : mFixture(mDirectory, "repo", 20) {}
+
+    // The file is tracked and its base version differs, unless the content is the same
+    wxString AddFile(const std::string& path, const std::string& baseContent, const std::string& content)
+    {
+        const std::string baseId = mFixture.AddBlob(baseContent);
+        mTreeEntries.push_back({ "100644", path, baseId });
+
+        havGSDGitFixture::havGSDIndexEntry indexEntry;
+        indexEntry.mPath = path;
+        indexEntry.mObjectId = (baseContent == content) ? baseId : mFixture.NewObjectId(content);
+
+        const wxString filePath = mDirectory.WriteFile("repo/" + wxString::FromUTF8(path.c_str()), content);
+
+        // Size and time like git stored them when it wrote the file
+        indexEntry.mSize = static_cast<uint32_t>(content.size());
+        indexEntry.mModificationTime = static_cast<uint32_t>(wxFileModificationTime(filePath));
+        mIndexEntries.push_back(indexEntry);
+
+        return filePath;
+    }
+
+    // The base version is listed in the tree, but its object is missing
+    wxString AddFileWithMissingBase(const std::string& path, const std::string& content)
+    {
+        mTreeEntries.push_back({ "100644", path, mFixture.NewObjectId("missing " + path) });
+        return mDirectory.WriteFile("repo/" + wxString::FromUTF8(path.c_str()), content);
+    }
+
+    // New since the base commit
+    wxString AddNewFile(const std::string& path, const std::string& content)
+    {
+        return mDirectory.WriteFile("repo/" + wxString::FromUTF8(path.c_str()), content);
+    }
+
+    bool Open(havGSDBranchDelta& branchDelta, const wxString& baseRef = "main", bool cancelled = false)
+    {
+        mFixture.SetRef("refs/heads/main", mFixture.AddCommit(mFixture.AddTree(mTreeEntries)));
+        mFixture.WriteIndex(2, mIndexEntries);
+
+        const std::atomic<bool> cancel(cancelled);
+        return branchDelta.Open(mDirectory.GetFilePath("repo"), baseRef, cancel);
+    }
+
+private:
+    havGSDTestDirectory mDirectory;
+    havGSDGitFixture mFixture;
+    std::vector<havGSDGitFixture::havGSDTreeEntry> mTreeEntries;
+    std::vector<havGSDGitFixture::havGSDIndexEntry> mIndexEntries;
+};
+
+// Line numbers of the added lines, or { 0 } if the whole file counts as added, or {} if there are none
+static std::vector<std::size_t> GetAddedLineNumbers(havGSDBranchDelta& branchDelta, const wxString& filePath)
+{
+    const std::atomic<bool> cancel(false);
+    std::vector<bool> addedLines;
+
+    if (!branchDelta.GetAddedLines(filePath, addedLines, cancel))
+    {
+        return {};
+    }
+
+    if (addedLines.empty())
+    {
+        return { 0 };
+    }
+
+    std::vector<std::size_t> lineNumbers;
+    for (std::size_t line = 0; line < addedLines.size(); ++line)
+    {
+        if (addedLines[line])
+        {
+            lineNumbers.push_back(line);
+        }
+    }
+
+    return lineNumbers;
+}
+
+using havGSDLineNumbers = std::vector<std::size_t>;
+
+static void TestAddedLines()
+{
+    havGSDBranchFixture branchFixture;
+
+    const wxString unchanged = branchFixture.AddFile("unchanged.cpp", "a\nb\n", "a\nb\n");
+    const wxString inserted = branchFixture.AddFile("src/inserted.cpp", "a\nb\nc\n", "a\nx\ny\nb\nc\nz\n");
+    const wxString modified = branchFixture.AddFile("src/modified.cpp", "a\nb\nc\n", "a\nB\nc\n");
+    const wxString deleted = branchFixture.AddFile("deleted.cpp", "a\nb\nc\nd\n", "a\nd\n");
+    const wxString emptied = branchFixture.AddFile("emptied.cpp", "a\nb\n", "");
+    const wxString fromEmpty = branchFixture.AddFile("from_empty.cpp", "", "a\nb\n");
+    const wxString lastLine = branchFixture.AddFile("last_line.cpp", "a\nb", "a\nb\nc");
+    const wxString lineBreakAdded = branchFixture.AddFile("line_break.cpp", "a\nb", "a\nb\n");
+    const wxString crlf = branchFixture.AddFile("crlf.cpp", "a\nb\n", "a\r\nb\r\nc\r\n");
+    const wxString carriageReturn = branchFixture.AddFile("carriage_return.cpp", "a\rb\n", "a\rb\na\n");
+    const wxString missingBase = branchFixture.AddFileWithMissingBase("missing_base.cpp", "a\nb\n");
+    const wxString added = branchFixture.AddNewFile("added.cpp", "a\n");
+
+    havGSDBranchDelta branchDelta;
+    HAVGSD_CHECK(branchFixture.Open(branchDelta));
+    HAVGSD_CHECK(branchDelta.IsOpen());
+
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, unchanged).empty());
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, inserted) == havGSDLineNumbers({ 2, 3, 6 }));
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, modified) == havGSDLineNumbers({ 2 }));
+
+    // Changes which only delete lines have nothing to show
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, deleted).empty());
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, emptied).empty());
+
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, fromEmpty) == havGSDLineNumbers({ 1, 2 }));
+
+    // The last line needs no line break, adding one changes no line
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, lastLine) == havGSDLineNumbers({ 3 }));
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, lineBreakAdded).empty());
+
+    // Checkouts with CRLF match their base, a '\r' within a line is part of it
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, crlf) == havGSDLineNumbers({ 3 }));
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, carriageReturn) == havGSDLineNumbers({ 2 }));
+
+    // A base version which can't be read counts as missing, all lines are new
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, missingBase) == havGSDLineNumbers({ 1, 2 }));
+
+    // All lines of files missing in the base are new
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, added) == havGSDLineNumbers({ 1 }));
+
+    // Files which can't be read have no tasks
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, added + ".missing").empty());
+
+    // A cancelled comparison finds nothing
+    const std::atomic<bool> cancel(true);
+    std::vector<bool> addedLines;
+    HAVGSD_CHECK(!branchDelta.GetAddedLines(inserted, addedLines, cancel));
+
+    // Opening stops between the entries of the index and of the trees
+    havGSDBranchDelta cancelledBranchDelta;
+    HAVGSD_CHECK(!branchFixture.Open(cancelledBranchDelta, "main", true));
+    HAVGSD_CHECK(!cancelledBranchDelta.IsOpen());
+
+    havGSDBranchDelta unknownRefBranchDelta;
+    HAVGSD_CHECK(!branchFixture.Open(unknownRefBranchDelta, "unknown"));
+    HAVGSD_CHECK(!unknownRefBranchDelta.IsOpen());
+}
+
+static void TestLimits()
+{
+    havGSDBranchFixture branchFixture;
+
+    // Every other line replaced, a shortest edit script is longer than MaxEditDistance, so all lines between the common start and end count as added
+    std::string baseContent;
+    std::string content;
+    const std::size_t lineCount = havGSDBranchDelta::MaxEditDistance + 2;
+
+    for (std::size_t line = 0; line < lineCount; ++line)
+    {
+        baseContent += "line " + std::to_string(line) + "\n";
+        content += (line % 2 == 0) ? "line " + std::to_string(line) + "\n" : "changed " + std::to_string(line) + "\n";
+    }
+
+    const wxString rewritten = branchFixture.AddFile("rewritten.cpp", baseContent, content);
+
+    // Small changes in a long file are found exactly
+    const std::string longContent = baseContent + baseContent;
+    const wxString longFile = branchFixture.AddFile("long.cpp", longContent, longContent.substr(0, baseContent.size()) + "new\n" + baseContent);
+
+    // Files with more lines than MaxLineCount aren't compared
+    const wxString huge = branchFixture.AddFile("huge.txt", "x\n", std::string(2 * (havGSDBranchDelta::MaxLineCount + 1), '\n'));
+
+    havGSDBranchDelta branchDelta;
+    HAVGSD_CHECK(branchFixture.Open(branchDelta));
+
+    // All lines after the common first line
+    havGSDLineNumbers changedLines;
+    for (std::size_t line = 2; line <= lineCount; ++line)
+    {
+        changedLines.push_back(line);
+    }
+
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, rewritten) == changedLines);
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, longFile) == havGSDLineNumbers({ lineCount + 1 }));
+    HAVGSD_CHECK(GetAddedLineNumbers(branchDelta, huge) == havGSDLineNumbers({ 0 }));
+}
+
+// Length of the longest common subsequence, the added lines of a shortest edit script are the others
+static std::size_t GetCommonLength(const std::vector<std::string>& baseLines, const std::vector<std::string>& lines)
+{
+    std::vector<std::vector<std::size_t>> lengths(baseLines.size() + 1, std::vector<std::size_t>(lines.size() + 1, 0));
+
+    for (std::size_t baseIndex = 1; baseIndex <= baseLines.size(); ++baseIndex)
+    {
+        for (std::size_t index = 1; index <= lines.size(); ++index)
+        {
+            lengths[baseIndex][index] = (baseLines[baseIndex - 1] == lines[index - 1])
+                                            ? lengths[baseIndex - 1][index - 1] + 1
+                                            : std::max(lengths[baseIndex - 1][index], lengths[baseIndex][index - 1]);
+        }
+    }
+
+    return lengths[baseLines.size()][lines.size()];
+}
+
+// Random edits of random files, compared with the longest common subsequence
+static void TestShortestEditScripts()
+{
+    havGSDBranchFixture branchFixture;
+
+    struct havGSDRandomFile
+    {
+        wxString mFilePath;
+        std::vector<std::string> mBaseLines;
+        std::vector<std::string> mLines;
+    };
+
+    std::mt19937 random(35);
+    std::vector<havGSDRandomFile> randomFiles(300);
+
+    for (std::size_t fileIndex = 0; fileIndex < randomFiles.size(); ++fileIndex)
+    {
+        havGSDRandomFile& randomFile = randomFiles[fileIndex];
+
+        // Few distinct lines, so there are many equally long scripts
+        const std::size_t baseLineCount = random() % 40;
+        for (std::size_t line = 0; line < baseLineCount; ++line)
+        {
+            randomFile.mBaseLines.push_back(std::string(1, static_cast<char>('a' + random() % 4)));
+        }
+
+        for (const std::string& line : randomFile.mBaseLines)
+        {
+            const unsigned edit = random() % 10;
+
+            if (edit == 0)
+            {
+                continue;
+            }
+
+            if (edit == 1)
+            {
+                randomFile.mLines.push_back(std::string(1, static_cast<char>('a' + random() % 5)));
+            }
+
+            randomFile.mLines.push_back(line);
+        }
+
+        std::string baseContent;
+        for (const std::string& line : randomFile.mBaseLines)
+        {
+            baseContent += line + "\n";
+        }
+
+        std::string content;
+        for (const std::string& line : randomFile.mLines)
+        {
+            content += line + "\n";
+        }
+
+        randomFile.mFilePath = branchFixture.AddFile("random/" + std::to_string(fileIndex) + ".txt", baseContent, content + " ");
+
+        // The last line differs from any line of the base
+        randomFile.mLines.push_back(" ");
+    }
+
+    havGSDBranchDelta branchDelta;
+    HAVGSD_CHECK(branchFixture.Open(branchDelta));
+
+    for (const havGSDRandomFile& randomFile : randomFiles)
+    {
+        const havGSDLineNumbers addedLineNumbers = GetAddedLineNumbers(branchDelta, randomFile.mFilePath);
+
+        // As few added lines as possible
+        HAVGSD_CHECK(addedLineNumbers.size() == randomFile.mLines.size() - GetCommonLength(randomFile.mBaseLines, randomFile.mLines));
+
+        // The other lines appear in the base in the same order
+        std::vector<std::string> keptLines;
+        std::size_t addedIndex = 0;
+
+        for (std::size_t line = 1; line <= randomFile.mLines.size(); ++line)
+        {
+            if (addedIndex < addedLineNumbers.size() && addedLineNumbers[addedIndex] == line)
+            {
+                ++addedIndex;
+                continue;
+            }
+
+            keptLines.push_back(randomFile.mLines[line - 1]);
+        }
+
+        HAVGSD_CHECK(GetCommonLength(randomFile.mBaseLines, keptLines) == keptLines.size());
+    }
+}
+
+int main()
+{
+    wxInitializer initializer;
+
+    TestAddedLines();
+    TestLimits();
+    TestShortestEditScripts();
+
+    return havGSDTest::Finish("havGSDBranchDeltaTest");
+}
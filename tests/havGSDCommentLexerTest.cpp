@@ -0,0 +1,170 @@
+/*
+havGSDCommentLexerTest.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "havGSDCommentLexer.hpp"
+#include "havGSDTest.hpp"
+
+#include <wx/init.h>
+
+#include <string>
+
+// Marks the characters the scanner takes as comment text with '#', like havGSDScanner::ScanBytes() does
+// - A character belongs to the comment if the lexer is in a comment before or after it, so only the last character of an opener is marked
+// - Line breaks are kept, the lexer ends the line there
+static std::string GetCommentMask(const havGSDCommentLexer& commentLexer, const std::wstring& text)
+{
+    std::string mask;
+    havGSDCommentLexer::State state = havGSDCommentLexer::CodeState;
+
+    for (wchar_t character : text)
+    {
+        if (character == L'\n')
+        {
+            state = commentLexer.EndLine(state);
+            mask += '\n';
+            continue;
+        }
+
+        const havGSDCommentLexer::State nextState = commentLexer.Next(state, static_cast<wxChar>(character));
+        mask += (commentLexer.IsComment(state) || commentLexer.IsComment(nextState)) ? '#' : '.';
+        state = nextState;
+    }
+
+    return mask;
+}
+
+static std::string GetCommentMask(const wxString& fileName, const std::wstring& text)
+{
+    return GetCommentMask(havGSDLanguageTable::Get().Find(wxFileName(fileName)), text);
+}
+
+static void TestCppComments()
+{
+    const havGSDCommentLexer commentLexer({ { "//" }, { { "/*", "*/" } } });
+
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"int a; // TODO") == "........######");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"a /* b */ c") == "...######..");
+
+    // Division isn't a comment, neither is a lone opener character
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"a / b * c") == ".........");
+
+    // Block comments continue on the next line, line comments end with it
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"/* a\nb */ c\n// d\ne") == ".###\n####..\n.###\n.");
+
+    // The closer needs its own '*', "/*/" doesn't close, "/**/" does
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"/*/ a\nb") == ".####\n#");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"/**/ a") == ".###..");
+
+    // Repeated characters of the closer fall back like KMP
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"/* ***/ a") == ".######..");
+
+    // Openers inside comments are part of them
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"/* // */ a") == ".#######..");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"// /* a\nb") == ".######\n.");
+
+    // Characters beyond ASCII share a column of the transition table
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"/* \u00e9\u4e2d */ \u00e9") == ".#######..");
+
+    havGSDCommentLexer::State state = havGSDCommentLexer::CodeState;
+    for (wchar_t character : std::wstring(L"a // b"))
+    {
+        state = commentLexer.Next(state, static_cast<wxChar>(character));
+    }
+
+    HAVGSD_CHECK(commentLexer.IsLineComment(state));
+    HAVGSD_CHECK(commentLexer.EndLine(state) == havGSDCommentLexer::CodeState);
+}
+
+static void TestOverlappingOpeners()
+{
+    // "--" is a prefix of "--[[", it is decided once "--[[" can't match anymore
+    const havGSDCommentLexer commentLexer({ { "--" }, { { "--[[", "]]" } } });
+
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"a --[[ b ]] c") == "...########..");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"--[[ a\nb ]] c") == ".#####\n####..");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"-- a\nb") == ".###\n.");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"--[ a\nb") == ".####\n.");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"---[[ a\nb") == ".######\n.");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"a - b") == ".....");
+
+    // A line ending right after "--" ends the line comment as well
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"--\na") == ".#\n.");
+}
+
+static void TestFailureTransitions()
+{
+    // After a broken opener the lexer continues with its longest suffix, which may start another opener, like Aho-Corasick
+    const havGSDCommentLexer commentLexer({ {}, { { "<!--", "-->" } } });
+
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"<<!-- a --> b") == "....#######..");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"<!- a") == ".....");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"<!-- a --->b") == "...########.");
+    HAVGSD_CHECK(GetCommentMask(commentLexer, L"<!-- a -- > b\nc --> d") == "...##########\n#####..");
+}
+
+static void TestLanguageTable()
+{
+    HAVGSD_CHECK(GetCommentMask("main.cpp", L"a // b # c") == "...#######");
+    HAVGSD_CHECK(GetCommentMask("script.py", L"a // b # c") == ".......###");
+    HAVGSD_CHECK(GetCommentMask("CMakeLists.txt", L"a # b") == "..###");
+    HAVGSD_CHECK(GetCommentMask("SCRIPT.PY", L"a # b") == "..###");
+    HAVGSD_CHECK(GetCommentMask("module.psm1", L"<# a\nb #> c # d") == ".###\n####...###");
+    HAVGSD_CHECK(GetCommentMask("settings.ini", L"; a\n# b") == "###\n###");
+    HAVGSD_CHECK(GetCommentMask("query.sql", L"a -- b\n/* c */") == "...###\n.######");
+    HAVGSD_CHECK(GetCommentMask("style.css", L"a // b /* c */") == "........######");
+    HAVGSD_CHECK(GetCommentMask("page.html", L"<!-- a --> // b") == "...#######.....");
+
+    // Unknown languages are scanned for C++ comments
+    HAVGSD_CHECK(GetCommentMask("notes.unknown", L"a // b # c") == "...#######");
+    HAVGSD_CHECK(GetCommentMask("Makefile", L"a # b") == "..###");
+}
+
+int main()
+{
+    wxInitializer initializer;
+
+    TestCppComments();
+    TestOverlappingOpeners();
+    TestFailureTransitions();
+    TestLanguageTable();
+
+    return havGSDTest::Finish("havGSDCommentLexerTest");
+}
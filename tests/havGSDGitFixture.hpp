@@ -0,0 +1,515 @@
+/*
+havGSDGitFixture.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDGITFIXTURE_HPP
+#define HAVGSDGITFIXTURE_HPP
+
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/string.h>
+#include <wx/zstream.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "havGSDTest.hpp"
+
+// Writes the files of a git repository the way git lays them out, without running git
+// - Object IDs are made up from the content instead of hashing it, the readers never check them
+// - Checksums of the index and the packs are zeros for the same reason
+class havGSDGitFixture
+{
+public:
+    struct havGSDIndexEntry
+    {
+        std::string mPath; // Relative to the work tree with '/' as separator
+        std::string mObjectId;
+        uint32_t mModificationTime = 0;
+        uint32_t mSize = 0;
+        int mStage = 0;             // Merge conflicts have the stages 1 to 3
+        bool mExtendedFlags = false; // Version 3 and later
+    };
+
+    struct havGSDTreeEntry
+    {
+        std::string mMode;
+        std::string mName;
+        std::string mObjectId;
+    };
+
+    // Creates "<work tree>/.git", SHA-256 repositories have 32 byte object IDs
+    havGSDGitFixture(const havGSDTestDirectory& directory, const wxString& workTree, std::size_t hashSize)
+        : mDirectory(directory), mWorkTree(workTree), mHashSize(hashSize)
+    {
+        WriteGitFile("HEAD", "ref: refs/heads/main\n");
+        WriteGitFile("config", (hashSize == 32) ? "[core]\n\trepositoryformatversion = 1\n[extensions]\n\tobjectFormat = sha256\n"
+                                                : "[core]\n\trepositoryformatversion = 0\n");
+        wxFileName::Mkdir(GetGitDirectory() + "/objects", wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    }
+
+    wxString GetGitDirectory() const { return mDirectory.GetFilePath(mWorkTree + "/.git"); }
+
+    std::size_t GetHashSize() const { return mHashSize; }
+
+    // Unique ID of a new object, its first byte varies so the objects spread over the fanout of a pack
+    std::string NewObjectId(const std::string& content)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+
+        for (char character : content)
+        {
+            hash = (hash ^ static_cast<unsigned char>(character)) * 1099511628211ULL;
+        }
+
+        hash ^= ++mObjectCount * 0x9E3779B97F4A7C15ULL;
+
+        std::string objectId(mHashSize, '\0');
+        for (std::size_t index = 0; index < mHashSize; ++index)
+        {
+            objectId[index] = static_cast<char>((hash >> ((index % 8) * 8)) ^ (index / 8));
+        }
+
+        return objectId;
+    }
+
+    static std::string ToHex(const std::string& objectId)
+    {
+        static const char digits[] = "0123456789abcdef";
+
+        std::string hex;
+        for (char character : objectId)
+        {
+            hex += digits[(static_cast<unsigned char>(character) >> 4) & 0x0F];
+            hex += digits[static_cast<unsigned char>(character) & 0x0F];
+        }
+
+        return hex;
+    }
+
+    static std::string Compress(const std::string& data)
+    {
+        wxMemoryOutputStream memoryStream;
+
+        {
+            wxZlibOutputStream zlibStream(memoryStream, -1, wxZLIB_ZLIB);
+            zlibStream.Write(data.data(), data.size());
+            zlibStream.Close();
+        }
+
+        std::string compressed(static_cast<std::size_t>(memoryStream.GetLength()), '\0');
+        memoryStream.CopyTo(&compressed[0], compressed.size());
+        return compressed;
+    }
+
+    // Loose object "objects/<first byte>/<rest>", the size in its header can be given for damaged objects
+    std::string AddLooseObject(const std::string& type, const std::string& data, const std::string& sizeInHeader = std::string())
+    {
+        const std::string objectId = NewObjectId(type + data);
+        WriteLooseObject(objectId, type, data, sizeInHeader);
+        return objectId;
+    }
+
+    void WriteLooseObject(const std::string& objectId, const std::string& type, const std::string& data, const std::string& sizeInHeader = std::string())
+    {
+        const std::string hex = ToHex(objectId);
+        const std::string size = sizeInHeader.empty() ? std::to_string(data.size()) : sizeInHeader;
+
+        WriteGitFile("objects/" + hex.substr(0, 2) + "/" + hex.substr(2), Compress(type + " " + size + std::string(1, '\0') + data));
+    }
+
+    std::string AddBlob(const std::string& content) { return AddLooseObject("blob", content); }
+
+    // Entries in the given order, git sorts them but the readers don't depend on it
+    std::string AddTree(const std::vector<havGSDTreeEntry>& entries)
+    {
+        std::string data;
+        for (const havGSDTreeEntry& entry : entries)
+        {
+            data += entry.mMode + " " + entry.mName + std::string(1, '\0') + entry.mObjectId;
+        }
+
+        return AddLooseObject("tree", data);
+    }
+
+    std::string AddCommit(const std::string& treeId)
+    {
+        return AddLooseObject("commit", "tree " + ToHex(treeId) + "\nauthor havGSD <havgsd@example.com> 0 +0000\n"
+                                        "committer havGSD <havgsd@example.com> 0 +0000\n\nCommit\n");
+    }
+
+    std::string AddTag(const std::string& objectId)
+    {
+        return AddLooseObject("tag", "object " + ToHex(objectId) + "\ntype commit\ntag v1\n\nTag\n");
+    }
+
+    // Loose ref like "refs/heads/main", pointing to an object or to another ref ("ref: <name>")
+    void SetRef(const std::string& refName, const std::string& objectId) { WriteGitFile(refName, ToHex(objectId) + "\n"); }
+
+    void SetSymbolicRef(const std::string& refName, const std::string& target) { WriteGitFile(refName, "ref: " + target + "\n"); }
+
+    void SetPackedRefs(const std::vector<std::pair<std::string, std::string>>& refs)
+    {
+        std::string content = "# pack-refs with: peeled fully-peeled sorted\n";
+        for (const auto& [refName, objectId] : refs)
+        {
+            content += ToHex(objectId) + " " + refName + "\n";
+        }
+
+        WriteGitFile("packed-refs", content);
+    }
+
+    // Index of the given version, the entries are written in the given order, linked worktrees have their index below "worktrees"
+    void WriteIndex(uint32_t version, const std::vector<havGSDIndexEntry>& entries, const std::string& indexPath = "index",
+                    const std::string& checksum = std::string())
+    {
+        std::string data = "DIRC";
+        AppendUInt32(data, version);
+        AppendUInt32(data, static_cast<uint32_t>(entries.size()));
+
+        std::string previousPath;
+
+        for (const havGSDIndexEntry& entry : entries)
+        {
+            const std::size_t entryStart = data.size();
+
+            // ctime, mtime, dev, ino, mode, uid, gid, size
+            AppendUInt32(data, entry.mModificationTime);
+            AppendUInt32(data, 0);
+            AppendUInt32(data, entry.mModificationTime);
+            AppendUInt32(data, 0);
+            AppendUInt32(data, 0);
+            AppendUInt32(data, 0);
+            AppendUInt32(data, 0100644);
+            AppendUInt32(data, 0);
+            AppendUInt32(data, 0);
+            AppendUInt32(data, entry.mSize);
+
+            data += entry.mObjectId;
+
+            const uint32_t flags = (entry.mExtendedFlags ? 0x4000u : 0u) | (static_cast<uint32_t>(entry.mStage) << 12) |
+                                   static_cast<uint32_t>(std::min<std::size_t>(entry.mPath.size(), 0x0FFF));
+            AppendUInt16(data, flags);
+
+            if (entry.mExtendedFlags)
+            {
+                AppendUInt16(data, 0);
+            }
+
+            if (version == 4)
+            {
+                // Number of bytes stripped from the end of the previous path, followed by the rest of the path
+                std::size_t commonLength = 0;
+                while (commonLength < previousPath.size() && commonLength < entry.mPath.size() && previousPath[commonLength] == entry.mPath[commonLength])
+                {
+                    ++commonLength;
+                }
+
+                AppendOffset(data, previousPath.size() - commonLength);
+                data += entry.mPath.substr(commonLength);
+                data += '\0';
+
+                previousPath = entry.mPath;
+            }
+            else
+            {
+                // NUL terminated and padded to a multiple of 8 bytes
+                data += entry.mPath;
+                data.append(8 - (data.size() - entryStart) % 8, '\0');
+            }
+        }
+
+        data += checksum.empty() ? std::string(mHashSize, '\0') : checksum;
+
+        WriteGitFile(indexPath, data);
+    }
+
+    // File below the git directory, the path is given with '/' as separator
+    void WriteGitFile(const std::string& relativePath, const std::string& content) const
+    {
+        havGSDTestDirectory::WriteFileAt(GetGitDirectory() + "/" + wxString::FromUTF8(relativePath.c_str()), content);
+    }
+
+    static void AppendUInt32(std::string& data, uint32_t value)
+    {
+        data += static_cast<char>((value >> 24) & 0xFF);
+        data += static_cast<char>((value >> 16) & 0xFF);
+        data += static_cast<char>((value >> 8) & 0xFF);
+        data += static_cast<char>(value & 0xFF);
+    }
+
+    static void AppendUInt16(std::string& data, uint32_t value)
+    {
+        data += static_cast<char>((value >> 8) & 0xFF);
+        data += static_cast<char>(value & 0xFF);
+    }
+
+    // Variable-length offset encoding of git, each continuation adds one before shifting
+    static void AppendOffset(std::string& data, uint64_t value)
+    {
+        std::string bytes(1, static_cast<char>(value & 0x7F));
+
+        while (value >>= 7)
+        {
+            --value;
+            bytes.insert(bytes.begin(), static_cast<char>(0x80 | (value & 0x7F)));
+        }
+
+        data += bytes;
+    }
+
+private:
+    const havGSDTestDirectory& mDirectory;
+    wxString mWorkTree;
+    std::size_t mHashSize;
+    uint64_t mObjectCount = 0;
+};
+
+// Copy and insert instructions of a delta, the sizes are written in front by Build()
+class havGSDGitDelta
+{
+public:
+    havGSDGitDelta& Copy(uint64_t offset, uint64_t size)
+    {
+        // A size of 0x10000 is written as no size bytes at all
+        const uint64_t writtenSize = (size == 0x10000) ? 0 : size;
+
+        std::string arguments;
+        unsigned char instruction = 0x80;
+
+        for (int bit = 0; bit < 4; ++bit)
+        {
+            const unsigned char byte = static_cast<unsigned char>((offset >> (bit * 8)) & 0xFF);
+            if (byte != 0)
+            {
+                instruction |= static_cast<unsigned char>(1 << bit);
+                arguments += static_cast<char>(byte);
+            }
+        }
+
+        for (int bit = 0; bit < 3; ++bit)
+        {
+            const unsigned char byte = static_cast<unsigned char>((writtenSize >> (bit * 8)) & 0xFF);
+            if (byte != 0)
+            {
+                instruction |= static_cast<unsigned char>(1 << (bit + 4));
+                arguments += static_cast<char>(byte);
+            }
+        }
+
+        mInstructions += static_cast<char>(instruction);
+        mInstructions += arguments;
+        mResultSize += size;
+        return *this;
+    }
+
+    // Inserts of up to 127 bytes each
+    havGSDGitDelta& Insert(const std::string& data)
+    {
+        for (std::size_t position = 0; position < data.size(); position += 127)
+        {
+            const std::string part = data.substr(position, 127);
+            mInstructions += static_cast<char>(part.size());
+            mInstructions += part;
+        }
+
+        mResultSize += data.size();
+        return *this;
+    }
+
+    // The result size can be given for damaged deltas
+    std::string Build(uint64_t baseSize) const { return Build(baseSize, mResultSize); }
+
+    std::string Build(uint64_t baseSize, uint64_t resultSize) const
+    {
+        std::string delta;
+        AppendSize(delta, baseSize);
+        AppendSize(delta, resultSize);
+        return delta + mInstructions;
+    }
+
+    static void AppendSize(std::string& data, uint64_t size)
+    {
+        do
+        {
+            unsigned char byte = static_cast<unsigned char>(size & 0x7F);
+            size >>= 7;
+
+            if (size != 0)
+            {
+                byte |= 0x80;
+            }
+
+            data += static_cast<char>(byte);
+        } while (size != 0);
+    }
+
+private:
+    std::string mInstructions;
+    uint64_t mResultSize = 0;
+};
+
+// Pack file with its index (version 2), objects are appended in order
+class havGSDGitPack
+{
+public:
+    static constexpr int Commit = 1;
+    static constexpr int Tree = 2;
+    static constexpr int Blob = 3;
+    static constexpr int Tag = 4;
+    static constexpr int OffsetDelta = 6;
+    static constexpr int RefDelta = 7;
+
+    explicit havGSDGitPack(havGSDGitFixture& fixture) : mFixture(fixture)
+    {
+        mPack = "PACK";
+        havGSDGitFixture::AppendUInt32(mPack, 2);
+        havGSDGitFixture::AppendUInt32(mPack, 0); // Object count, set by Write()
+    }
+
+    // Returns the offset of the object, the size in its header can be given for damaged objects
+    uint64_t AddObject(int type, const std::string& data, std::string& objectId, uint64_t sizeInHeader = UINT64_MAX)
+    {
+        return Append(type, data, std::string(), objectId, sizeInHeader);
+    }
+
+    uint64_t AddOffsetDelta(uint64_t baseOffset, const std::string& delta, std::string& objectId)
+    {
+        std::string baseDistance;
+        havGSDGitFixture::AppendOffset(baseDistance, mPack.size() - baseOffset);
+        return Append(OffsetDelta, delta, baseDistance, objectId, UINT64_MAX);
+    }
+
+    uint64_t AddRefDelta(const std::string& baseId, const std::string& delta, std::string& objectId)
+    {
+        return Append(RefDelta, delta, baseId, objectId, UINT64_MAX);
+    }
+
+    // Offsets can be moved to the table of large offsets, which packs beyond 2 GiB use
+    void Write(const std::string& name, bool largeOffsets = false)
+    {
+        std::string pack = mPack;
+
+        std::string objectCount;
+        havGSDGitFixture::AppendUInt32(objectCount, static_cast<uint32_t>(mObjects.size()));
+        pack.replace(8, 4, objectCount);
+        pack.append(mFixture.GetHashSize(), '\0');
+
+        std::vector<std::pair<std::string, uint64_t>> objects = mObjects;
+        std::sort(objects.begin(), objects.end());
+
+        std::string index = "\377tOc";
+        havGSDGitFixture::AppendUInt32(index, 2);
+
+        for (int firstByte = 0; firstByte < 256; ++firstByte)
+        {
+            const auto count = std::count_if(objects.begin(), objects.end(),
+                [firstByte](const std::pair<std::string, uint64_t>& object) { return static_cast<unsigned char>(object.first[0]) <= firstByte; });
+            havGSDGitFixture::AppendUInt32(index, static_cast<uint32_t>(count));
+        }
+
+        for (const auto& object : objects)
+        {
+            index += object.first;
+        }
+
+        // CRCs
+        index.append(objects.size() * 4, '\0');
+
+        std::string largeOffsetTable;
+
+        for (const auto& object : objects)
+        {
+            if (largeOffsets)
+            {
+                havGSDGitFixture::AppendUInt32(index, 0x80000000u | static_cast<uint32_t>(largeOffsetTable.size() / 8));
+                havGSDGitFixture::AppendUInt32(largeOffsetTable, static_cast<uint32_t>(object.second >> 32));
+                havGSDGitFixture::AppendUInt32(largeOffsetTable, static_cast<uint32_t>(object.second & 0xFFFFFFFFu));
+            }
+            else
+            {
+                havGSDGitFixture::AppendUInt32(index, static_cast<uint32_t>(object.second));
+            }
+        }
+
+        index += largeOffsetTable;
+        index.append(2 * mFixture.GetHashSize(), '\0');
+
+        mFixture.WriteGitFile("objects/pack/pack-" + name + ".pack", pack);
+        mFixture.WriteGitFile("objects/pack/pack-" + name + ".idx", index);
+    }
+
+private:
+    havGSDGitFixture& mFixture;
+    std::string mPack;
+    std::vector<std::pair<std::string, uint64_t>> mObjects;
+
+    // Type and size: 3 bits type, 4 bits size, then 7 bits size per byte
+    uint64_t Append(int type, const std::string& data, const std::string& base, std::string& objectId, uint64_t sizeInHeader)
+    {
+        const uint64_t offset = mPack.size();
+        uint64_t size = (sizeInHeader == UINT64_MAX) ? data.size() : sizeInHeader;
+
+        unsigned char byte = static_cast<unsigned char>((type << 4) | (size & 0x0F));
+        size >>= 4;
+
+        while (size != 0)
+        {
+            mPack += static_cast<char>(byte | 0x80);
+            byte = static_cast<unsigned char>(size & 0x7F);
+            size >>= 7;
+        }
+
+        mPack += static_cast<char>(byte);
+        mPack += base;
+        mPack += havGSDGitFixture::Compress(data);
+
+        objectId = mFixture.NewObjectId(std::to_string(type) + data);
+        mObjects.emplace_back(objectId, offset);
+
+        return offset;
+    }
+};
+
+#endif
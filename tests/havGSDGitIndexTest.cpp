@@ -0,0 +1,257 @@
+/*
+havGSDGitIndexTest.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "havGSDGitFixture.hpp"
+#include "havGSDGitIndex.hpp"
+#include "havGSDTest.hpp"
+
+#include <wx/init.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+static std::vector<havGSDGitFixture::havGSDIndexEntry> GetIndexEntries(havGSDGitFixture& fixture, bool extendedFlags)
+{
+    std::vector<havGSDGitFixture::havGSDIndexEntry> entries(4);
+
+    entries[0].mPath = "main.cpp";
+    entries[0].mObjectId = fixture.NewObjectId("main.cpp");
+    entries[0].mModificationTime = 1700000000;
+    entries[0].mSize = 120;
+
+    entries[1].mPath = "src/parser.cpp";
+    entries[1].mObjectId = fixture.NewObjectId("src/parser.cpp");
+    entries[1].mModificationTime = 1700000100;
+    entries[1].mSize = 4096;
+    entries[1].mExtendedFlags = extendedFlags;
+
+    entries[2].mPath = "src/parser.hpp";
+    entries[2].mObjectId = fixture.NewObjectId("src/parser.hpp");
+    entries[2].mModificationTime = 1700000200;
+    entries[2].mSize = 300;
+
+    // Stage of a merge conflict, skipped
+    entries[3].mPath = "src/parser.hpp";
+    entries[3].mObjectId = fixture.NewObjectId("src/parser.hpp conflict");
+    entries[3].mStage = 2;
+
+    return entries;
+}
+
+static void CheckFingerprints(const havGSDTestDirectory& directory, const havGSDGitIndex::Fingerprints& fingerprints,
+                              const std::vector<havGSDGitFixture::havGSDIndexEntry>& entries)
+{
+    HAVGSD_CHECK(fingerprints.size() == 3);
+
+    for (std::size_t entryIndex = 0; entryIndex < 3; ++entryIndex)
+    {
+        const havGSDGitFixture::havGSDIndexEntry& entry = entries[entryIndex];
+        auto fingerprint = fingerprints.find(directory.GetFilePath("repo/" + wxString::FromUTF8(entry.mPath.c_str())));
+
+        HAVGSD_CHECK(fingerprint != fingerprints.end());
+
+        if (fingerprint != fingerprints.end())
+        {
+            HAVGSD_CHECK(fingerprint->second.mObjectId == entry.mObjectId);
+            HAVGSD_CHECK(fingerprint->second.mModificationTime == entry.mModificationTime);
+            HAVGSD_CHECK(fingerprint->second.mSize == entry.mSize);
+        }
+    }
+}
+
+static void TestIndexVersions()
+{
+    for (uint32_t version = 2; version <= 4; ++version)
+    {
+        havGSDTestDirectory directory;
+        havGSDGitFixture fixture(directory, "repo", 20);
+
+        const std::vector<havGSDGitFixture::havGSDIndexEntry> entries = GetIndexEntries(fixture, version >= 3);
+        fixture.WriteIndex(version, entries);
+
+        // The repository is found from a directory below the work tree
+        wxFileName::Mkdir(directory.GetFilePath("repo/src/detail"), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+
+        havGSDGitIndex gitIndex;
+        HAVGSD_CHECK(gitIndex.Open(directory.GetFilePath("repo/src/detail")));
+        HAVGSD_CHECK(gitIndex.GetWorkTree() == directory.GetFilePath("repo"));
+        HAVGSD_CHECK(gitIndex.GetHashSize() == 20);
+
+        havGSDGitIndex::Fingerprints fingerprints;
+        HAVGSD_CHECK(gitIndex.Read(fingerprints));
+        CheckFingerprints(directory, fingerprints, entries);
+    }
+}
+
+static void TestDamagedIndex()
+{
+    havGSDTestDirectory directory;
+    havGSDGitFixture fixture(directory, "repo", 20);
+
+    havGSDGitIndex gitIndex;
+    HAVGSD_CHECK(gitIndex.Open(directory.GetFilePath("repo")));
+
+    havGSDGitIndex::Fingerprints fingerprints;
+
+    // Missing index
+    HAVGSD_CHECK(!gitIndex.Read(fingerprints));
+
+    // Extended flags need version 3
+    fixture.WriteIndex(2, GetIndexEntries(fixture, true));
+    HAVGSD_CHECK(!gitIndex.Read(fingerprints));
+
+    fixture.WriteIndex(5, GetIndexEntries(fixture, false));
+    HAVGSD_CHECK(!gitIndex.Read(fingerprints));
+
+    // Wrong signature, entries beyond the end and an empty file
+    std::string data;
+    fixture.WriteIndex(2, GetIndexEntries(fixture, false));
+
+    wxFile file;
+    HAVGSD_CHECK(file.Open(fixture.GetGitDirectory() + "/index"));
+    data.resize(static_cast<std::size_t>(file.Length()));
+    HAVGSD_CHECK(file.Read(&data[0], data.size()) == static_cast<ssize_t>(data.size()));
+    file.Close();
+
+    HAVGSD_CHECK(gitIndex.Read(fingerprints));
+
+    std::string damagedData = data;
+    damagedData[3] = 'X';
+    fixture.WriteGitFile("index", damagedData);
+    HAVGSD_CHECK(!gitIndex.Read(fingerprints));
+
+    fixture.WriteGitFile("index", data.substr(0, data.size() - 40));
+    HAVGSD_CHECK(!gitIndex.Read(fingerprints));
+
+    fixture.WriteGitFile("index", std::string());
+    HAVGSD_CHECK(!gitIndex.Read(fingerprints));
+    HAVGSD_CHECK(fingerprints.empty());
+
+    // A .git file must refer to the git directory
+    havGSDTestDirectory otherDirectory;
+    otherDirectory.WriteFile("repo/.git", "not a git directory\n");
+    HAVGSD_CHECK(!gitIndex.Open(otherDirectory.GetFilePath("repo")));
+    HAVGSD_CHECK(!gitIndex.IsOpen());
+}
+
+static void TestChecksum()
+{
+    havGSDTestDirectory directory;
+    havGSDGitFixture fixture(directory, "repo", 20);
+
+    const std::string checksum = fixture.NewObjectId("checksum");
+    fixture.WriteIndex(2, GetIndexEntries(fixture, false), "index", checksum);
+
+    havGSDGitIndex gitIndex;
+    HAVGSD_CHECK(gitIndex.Open(directory.GetFilePath("repo")));
+
+    std::string readChecksum;
+    HAVGSD_CHECK(gitIndex.ReadChecksum(readChecksum));
+    HAVGSD_CHECK(readChecksum == checksum);
+}
+
+// Linked worktrees have a .git file referring to their directory below "worktrees", which refers to the main one with "commondir"
+static void TestSha256Worktree()
+{
+    havGSDTestDirectory directory;
+    havGSDGitFixture fixture(directory, "main", 32);
+
+    fixture.WriteGitFile("worktrees/feature/commondir", "../..\n");
+    fixture.WriteGitFile("worktrees/feature/HEAD", "ref: refs/heads/feature\n");
+    directory.WriteFile("feature/.git", "gitdir: ../main/.git/worktrees/feature\n");
+
+    std::vector<havGSDGitFixture::havGSDIndexEntry> entries = GetIndexEntries(fixture, false);
+    fixture.WriteIndex(2, entries, "worktrees/feature/index");
+
+    havGSDGitIndex gitIndex;
+    HAVGSD_CHECK(gitIndex.Open(directory.GetFilePath("feature")));
+    HAVGSD_CHECK(gitIndex.GetHashSize() == 32);
+    HAVGSD_CHECK(gitIndex.GetWorkTree() == directory.GetFilePath("feature"));
+
+    havGSDGitIndex::Fingerprints fingerprints;
+    HAVGSD_CHECK(gitIndex.Read(fingerprints));
+    HAVGSD_CHECK(fingerprints.size() == 3);
+
+    auto fingerprint = fingerprints.find(directory.GetFilePath("feature/src/parser.cpp"));
+    HAVGSD_CHECK(fingerprint != fingerprints.end() && fingerprint->second.mObjectId == entries[1].mObjectId);
+
+    // The key of the setting ignores case and the value may be surrounded by spaces
+    fixture.WriteGitFile("config", "[extensions]\n    ObjectFormat=  sha256\n");
+    HAVGSD_CHECK(gitIndex.Open(directory.GetFilePath("feature")) && gitIndex.GetHashSize() == 32);
+
+    fixture.WriteGitFile("config", "[extensions]\n\tobjectFormat = sha1\n");
+    HAVGSD_CHECK(gitIndex.Open(directory.GetFilePath("feature")) && gitIndex.GetHashSize() == 20);
+}
+
+static void TestCompare()
+{
+    havGSDGitIndex::Fingerprints oldFingerprints;
+    oldFingerprints["/repo/unchanged.cpp"].mObjectId = "1";
+    oldFingerprints["/repo/changed.cpp"].mObjectId = "2";
+    oldFingerprints["/repo/removed.cpp"].mObjectId = "3";
+
+    havGSDGitIndex::Fingerprints newFingerprints;
+    newFingerprints["/repo/unchanged.cpp"].mObjectId = "1";
+    newFingerprints["/repo/changed.cpp"].mObjectId = "4";
+    newFingerprints["/repo/added.cpp"].mObjectId = "5";
+
+    // Only the object ID counts, a new time or size alone is no change of the content
+    newFingerprints["/repo/unchanged.cpp"].mModificationTime = 1;
+
+    std::multiset<wxString> changedFilePaths;
+    havGSDGitIndex::Compare(oldFingerprints, newFingerprints, [&](const wxString& filePath) { changedFilePaths.insert(filePath); });
+
+    HAVGSD_CHECK(changedFilePaths == std::multiset<wxString>({ "/repo/changed.cpp", "/repo/removed.cpp", "/repo/added.cpp" }));
+}
+
+int main()
+{
+    wxInitializer initializer;
+
+    TestIndexVersions();
+    TestDamagedIndex();
+    TestChecksum();
+    TestSha256Worktree();
+    TestCompare();
+
+    return havGSDTest::Finish("havGSDGitIndexTest");
+}
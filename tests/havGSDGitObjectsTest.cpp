@@ -0,0 +1,322 @@
+/*
+havGSDGitObjectsTest.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "havGSDGitFixture.hpp"
+#include "havGSDGitObjects.hpp"
+#include "havGSDTest.hpp"
+
+#include <wx/init.h>
+
+#include <map>
+#include <string>
+
+using havGSDObjectType = havGSDGitObjects::havGSDObjectType;
+
+static std::map<std::string, std::string> ReadTreeFiles(havGSDGitObjects& gitObjects, const std::string& treeId, bool& read)
+{
+    std::map<std::string, std::string> files;
+    auto addFile = [&](const std::string& path, const std::string& objectId) { files[path] = objectId; };
+
+    read = gitObjects.ReadTree(treeId, std::string(), addFile);
+    return files;
+}
+
+static void TestLooseObjectsAndRefs()
+{
+    for (std::size_t hashSize : { 20, 32 })
+    {
+        havGSDTestDirectory directory;
+        havGSDGitFixture fixture(directory, "repo", hashSize);
+
+        const std::string mainId = fixture.AddBlob("int main() {}\n");
+        const std::string parserId = fixture.AddBlob("// TODO parse\n");
+        const std::string emptyId = fixture.AddBlob("");
+
+        const std::string sourceTreeId = fixture.AddTree({ { "100644", "parser.cpp", parserId }, { "100644", "empty.txt", emptyId } });
+        const std::string treeId = fixture.AddTree({ { "100644", "main.cpp", mainId }, { "40000", "src", sourceTreeId },
+                                                     { "160000", "external", fixture.NewObjectId("submodule commit") } });
+        const std::string commitId = fixture.AddCommit(treeId);
+        const std::string tagId = fixture.AddTag(commitId);
+
+        fixture.SetRef("refs/heads/main", commitId);
+        fixture.SetRef("refs/tags/v1", tagId);
+        fixture.SetPackedRefs({ { "refs/remotes/origin/main", commitId } });
+        fixture.SetSymbolicRef("refs/remotes/origin/HEAD", "refs/remotes/origin/main");
+
+        havGSDGitObjects gitObjects;
+        HAVGSD_CHECK(gitObjects.Open(fixture.GetGitDirectory(), hashSize));
+
+        std::string data;
+        HAVGSD_CHECK(gitObjects.ReadBlob(mainId, data) && data == "int main() {}\n");
+        HAVGSD_CHECK(gitObjects.ReadBlob(emptyId, data) && data.empty());
+
+        // Only blobs are read as blobs, unknown objects can't be read
+        HAVGSD_CHECK(!gitObjects.ReadBlob(treeId, data));
+        HAVGSD_CHECK(!gitObjects.ReadBlob(fixture.NewObjectId("missing"), data));
+
+        havGSDObjectType type = havGSDObjectType::None;
+        HAVGSD_CHECK(gitObjects.ReadObject(commitId, type, data) && type == havGSDObjectType::Commit);
+
+        // Branches, tags, remotes, their HEAD, symbolic refs and full object IDs resolve to the tree of the commit
+        const wxString refs[] = { "main", "refs/heads/main", "HEAD", "v1", "origin/main", "origin", " main ",
+                                  wxString::FromUTF8(havGSDGitFixture::ToHex(commitId).c_str()) };
+
+        for (const wxString& ref : refs)
+        {
+            std::string resolvedTreeId;
+            HAVGSD_CHECK(gitObjects.ResolveTree(ref, resolvedTreeId) && resolvedTreeId == treeId);
+        }
+
+        std::string resolvedTreeId;
+        HAVGSD_CHECK(!gitObjects.ResolveTree("unknown", resolvedTreeId));
+        HAVGSD_CHECK(!gitObjects.ResolveTree("", resolvedTreeId));
+        HAVGSD_CHECK(!gitObjects.ResolveTree("../../../etc", resolvedTreeId));
+
+        // Files of subdirectories are listed with their path, submodules are skipped
+        bool read = false;
+        const std::map<std::string, std::string> files = ReadTreeFiles(gitObjects, treeId, read);
+
+        HAVGSD_CHECK(read);
+        HAVGSD_CHECK(files == (std::map<std::string, std::string>{ { "main.cpp", mainId }, { "src/parser.cpp", parserId }, { "src/empty.txt", emptyId } }));
+    }
+}
+
+static void TestDamagedLooseObjects()
+{
+    havGSDTestDirectory directory;
+    havGSDGitFixture fixture(directory, "repo", 20);
+
+    // The size in the header must match the content
+    const std::string wrongSizeId = fixture.AddLooseObject("blob", "content", "6");
+    const std::string unknownTypeId = fixture.AddLooseObject("note", "content");
+
+    const std::string truncatedId = fixture.NewObjectId("truncated");
+    fixture.WriteGitFile("objects/" + havGSDGitFixture::ToHex(truncatedId).substr(0, 2) + "/" + havGSDGitFixture::ToHex(truncatedId).substr(2),
+                         havGSDGitFixture::Compress("blob 7").substr(0, 5));
+
+    // Inflated objects beyond the limit aren't read completely
+    const std::string largeId = fixture.AddBlob(std::string(havGSDGitObjects::MaxObjectSize + 1, 'a'));
+
+    havGSDGitObjects gitObjects;
+    HAVGSD_CHECK(gitObjects.Open(fixture.GetGitDirectory(), 20));
+
+    std::string data;
+    HAVGSD_CHECK(!gitObjects.ReadBlob(wrongSizeId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(unknownTypeId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(truncatedId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(largeId, data));
+
+    // Object IDs of the wrong size are rejected
+    HAVGSD_CHECK(!gitObjects.ReadBlob(wrongSizeId.substr(1), data));
+}
+
+static void TestPackedObjects()
+{
+    for (bool largeOffsets : { false, true })
+    {
+        havGSDTestDirectory directory;
+        havGSDGitFixture fixture(directory, "repo", 20);
+
+        // More than 0x10000 bytes, copies of exactly 0x10000 bytes are written without a size
+        std::string base;
+        for (int line = 0; base.size() <= 0x10000 + 100; ++line)
+        {
+            base += "// Line " + std::to_string(line) + "\n";
+        }
+
+        havGSDGitPack pack(fixture);
+
+        std::string baseId;
+        const uint64_t baseOffset = pack.AddObject(havGSDGitPack::Blob, base, baseId);
+
+        // Delta on the base by its offset
+        const std::string firstResult = base.substr(0, 0x10000) + "// TODO inserted\n" + base.substr(0x10000 + 10);
+        const std::string firstDelta = havGSDGitDelta().Copy(0, 0x10000).Insert("// TODO inserted\n").Copy(0x10000 + 10, base.size() - 0x10000 - 10).Build(base.size());
+
+        std::string firstId;
+        pack.AddOffsetDelta(baseOffset, firstDelta, firstId);
+
+        // Delta on the first delta by its object ID, inserts longer than 127 bytes are split
+        const std::string longInsert(300, 'x');
+        const std::string secondResult = longInsert + firstResult.substr(100, 50);
+        const std::string secondDelta = havGSDGitDelta().Insert(longInsert).Copy(100, 50).Build(firstResult.size());
+
+        std::string secondId;
+        const uint64_t secondOffset = pack.AddRefDelta(firstId, secondDelta, secondId);
+
+        // Delta on the second delta by its offset, a chain of three
+        const std::string thirdResult = secondResult.substr(290, 20);
+        std::string thirdId;
+        pack.AddOffsetDelta(secondOffset, havGSDGitDelta().Copy(290, 20).Build(secondResult.size()), thirdId);
+
+        std::string treeId;
+        pack.AddObject(havGSDGitPack::Tree, "100644 main.cpp" + std::string(1, '\0') + secondId, treeId);
+
+        std::string commitId;
+        pack.AddObject(havGSDGitPack::Commit, "tree " + havGSDGitFixture::ToHex(treeId) + "\n\nCommit\n", commitId);
+
+        pack.Write("0001", largeOffsets);
+        fixture.SetRef("refs/heads/main", commitId);
+
+        havGSDGitObjects gitObjects;
+        HAVGSD_CHECK(gitObjects.Open(fixture.GetGitDirectory(), 20));
+
+        std::string data;
+        HAVGSD_CHECK(gitObjects.ReadBlob(baseId, data) && data == base);
+        HAVGSD_CHECK(gitObjects.ReadBlob(firstId, data) && data == firstResult);
+        HAVGSD_CHECK(gitObjects.ReadBlob(secondId, data) && data == secondResult);
+        HAVGSD_CHECK(gitObjects.ReadBlob(thirdId, data) && data == thirdResult);
+
+        // Read again from the cache of delta bases
+        HAVGSD_CHECK(gitObjects.ReadBlob(secondId, data) && data == secondResult);
+
+        std::string resolvedTreeId;
+        HAVGSD_CHECK(gitObjects.ResolveTree("main", resolvedTreeId) && resolvedTreeId == treeId);
+
+        bool read = false;
+        const std::map<std::string, std::string> files = ReadTreeFiles(gitObjects, treeId, read);
+        HAVGSD_CHECK(read && files == (std::map<std::string, std::string>{ { "main.cpp", secondId } }));
+
+        // Objects of other packs and loose objects are found as well
+        const std::string looseId = fixture.AddBlob("loose");
+
+        havGSDGitPack otherPack(fixture);
+        std::string otherId;
+        otherPack.AddRefDelta(baseId, havGSDGitDelta().Copy(0, 8).Build(base.size()), otherId);
+        otherPack.Write("0002", largeOffsets);
+
+        HAVGSD_CHECK(gitObjects.Open(fixture.GetGitDirectory(), 20));
+        HAVGSD_CHECK(gitObjects.ReadBlob(looseId, data) && data == "loose");
+        HAVGSD_CHECK(gitObjects.ReadBlob(otherId, data) && data == base.substr(0, 8));
+    }
+}
+
+static void TestDamagedDeltas()
+{
+    havGSDTestDirectory directory;
+    havGSDGitFixture fixture(directory, "repo", 20);
+
+    const std::string base = "0123456789";
+
+    havGSDGitPack pack(fixture);
+
+    std::string baseId;
+    const uint64_t baseOffset = pack.AddObject(havGSDGitPack::Blob, base, baseId);
+
+    // Size of the base doesn't match
+    std::string wrongBaseSizeId;
+    pack.AddOffsetDelta(baseOffset, havGSDGitDelta().Copy(0, 5).Build(base.size() + 1), wrongBaseSizeId);
+
+    // Copy beyond the end of the base
+    std::string copyBeyondBaseId;
+    pack.AddOffsetDelta(baseOffset, havGSDGitDelta().Copy(8, 5).Build(base.size()), copyBeyondBaseId);
+
+    // Result size doesn't match the instructions
+    std::string wrongResultSizeId;
+    pack.AddOffsetDelta(baseOffset, havGSDGitDelta().Copy(0, 5).Build(base.size(), 6), wrongResultSizeId);
+
+    // Copies and inserts beyond the size of the result, refused before they are appended
+    std::string copyBeyondResultId;
+    havGSDGitDelta repeatedCopies;
+    for (int copy = 0; copy < 1000; ++copy)
+    {
+        repeatedCopies.Copy(0, base.size());
+    }
+
+    pack.AddOffsetDelta(baseOffset, repeatedCopies.Build(base.size(), base.size()), copyBeyondResultId);
+
+    std::string insertBeyondResultId;
+    pack.AddOffsetDelta(baseOffset, havGSDGitDelta().Copy(0, 5).Insert("abc").Build(base.size(), 6), insertBeyondResultId);
+
+    // Result larger than the limit, refused before anything is copied
+    std::string largeResultId;
+    pack.AddOffsetDelta(baseOffset, havGSDGitDelta().Copy(0, 5).Build(base.size(), havGSDGitObjects::MaxObjectSize + 1), largeResultId);
+
+    // Instruction 0 is reserved
+    std::string reservedInstructionId;
+    pack.AddOffsetDelta(baseOffset, havGSDGitDelta().Copy(0, 5).Build(base.size()) + std::string(1, '\0'), reservedInstructionId);
+
+    // Base missing in the repository
+    std::string missingBaseId;
+    pack.AddRefDelta(fixture.NewObjectId("missing"), havGSDGitDelta().Insert("a").Build(1), missingBaseId);
+
+    // Size in the header of the object beyond the limit, refused before anything is allocated
+    std::string largeObjectId;
+    pack.AddObject(havGSDGitPack::Blob, "small", largeObjectId, havGSDGitObjects::MaxObjectSize + 1);
+
+    // Size in the header larger than the compressed data
+    std::string truncatedObjectId;
+    pack.AddObject(havGSDGitPack::Blob, "small", truncatedObjectId, 6);
+
+    pack.Write("0001");
+
+    havGSDGitObjects gitObjects;
+    HAVGSD_CHECK(gitObjects.Open(fixture.GetGitDirectory(), 20));
+
+    std::string data;
+    HAVGSD_CHECK(gitObjects.ReadBlob(baseId, data) && data == base);
+    HAVGSD_CHECK(!gitObjects.ReadBlob(wrongBaseSizeId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(copyBeyondBaseId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(wrongResultSizeId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(copyBeyondResultId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(insertBeyondResultId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(largeResultId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(reservedInstructionId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(missingBaseId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(largeObjectId, data));
+    HAVGSD_CHECK(!gitObjects.ReadBlob(truncatedObjectId, data));
+
+    // Without an objects directory there is no repository
+    havGSDTestDirectory emptyDirectory;
+    HAVGSD_CHECK(!gitObjects.Open(emptyDirectory.GetPath(), 20));
+}
+
+int main()
+{
+    wxInitializer initializer;
+
+    TestLooseObjectsAndRefs();
+    TestDamagedLooseObjects();
+    TestPackedObjects();
+    TestDamagedDeltas();
+
+    return havGSDTest::Finish("havGSDGitObjectsTest");
+}
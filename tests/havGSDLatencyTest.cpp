@@ -0,0 +1,525 @@
+/*
+havGSDLatencyTest.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "havGSD.hpp"
+#include "havGSDTest.hpp"
+
+#include "event_notifier.h"
+#include "ieditor.h"
+#include "imanager.h"
+#include "project.h"
+#include "workspace.h"
+
+#include <wx/app.h>
+#include <wx/evtloop.h>
+#include <wx/filefn.h>
+#include <wx/frame.h>
+#include <wx/init.h>
+#include <wx/stopwatch.h>
+#include <wx/utils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Exit code of a skipped test, see SKIP_RETURN_CODE in CMakeLists.txt
+static constexpr int SkippedExitCode = 77;
+
+// Entry point of the plugin, as loaded by CodeLite
+CL_PLUGIN_API IPlugin* CreatePlugin(IManager* manager);
+
+// Stand-in for an open editor
+class havGSDTestEditor : public IEditor
+{
+public:
+    explicit havGSDTestEditor(const wxFileName& fileName) : mFileName(fileName) {}
+
+    const wxFileName& GetFileName() const override { return mFileName; }
+
+private:
+    wxFileName mFileName;
+};
+
+// Stand-in for the workspace, which is open while a project is active
+class havGSDTestWorkspace : public IWorkspace
+{
+public:
+    bool IsOpen() const override { return mActiveProject != nullptr; }
+    ProjectPtr GetActiveProject() const override { return mActiveProject; }
+
+    void SetActiveProject(const ProjectPtr& project) { mActiveProject = project; }
+
+private:
+    ProjectPtr mActiveProject;
+};
+
+// Stand-in for CodeLite given to the plugin
+class havGSDTestManager : public IManager
+{
+public:
+    explicit havGSDTestManager(wxWindow* mainPanel) : mMainPanel(mainPanel) {}
+
+    wxWindow* GetMainPanel() override { return mMainPanel; }
+    IWorkspace* GetWorkspace() override { return &mWorkspace; }
+
+    IEditor::List_t GetAllEditors() override
+    {
+        IEditor::List_t editors;
+
+        for (const auto& editor : mEditors)
+        {
+            editors.push_back(editor.get());
+        }
+
+        return editors;
+    }
+
+    // There are no editors to open the files in
+    bool OpenFile(const wxString& fileName, const wxString& projectName, int lineno) override
+    {
+        wxUnusedVar(fileName);
+        wxUnusedVar(projectName);
+        wxUnusedVar(lineno);
+        return false;
+    }
+
+    havGSDTestWorkspace& GetTestWorkspace() { return mWorkspace; }
+
+    void OpenEditor(const wxFileName& fileName) { mEditors.push_back(std::make_unique<havGSDTestEditor>(fileName)); }
+
+private:
+    wxWindow* mMainPanel;
+    havGSDTestWorkspace mWorkspace;
+    std::vector<std::unique_ptr<havGSDTestEditor>> mEditors;
+};
+
+// Project generated on disk, its files are changed by the test like by a user, who saves and renames them
+// - A task is a line comment starting with a keyword, one per task line
+// - Keywords outside of comments aren't tasks
+class havGSDTestProject
+{
+public:
+    static constexpr int LineCount = 200;
+
+    havGSDTestProject(const havGSDTestDirectory& directory, const wxString& name, int fileCount)
+    {
+        mProject = std::make_shared<Project>(name, wxFileName(directory.GetFilePath(name + "/" + name + ".project")));
+
+        for (int fileIndex = 0; fileIndex < fileCount; ++fileIndex)
+        {
+            havGSDTestFile file;
+            file.mContent = GetFileContent(fileIndex);
+            file.mPath = directory.WriteFile(wxString::Format("%s/src/file%d.cpp", name, fileIndex), file.mContent);
+            mFiles.push_back(file);
+        }
+
+        UpdateProjectFiles();
+    }
+
+    const ProjectPtr& GetProject() const { return mProject; }
+    int GetFileCount() const { return static_cast<int>(mFiles.size()); }
+    const wxString& GetFilePath(int fileIndex) const { return mFiles[fileIndex].mPath; }
+
+    // Adds a task at the end of the file and returns its path
+    wxString SaveFile(int fileIndex, const std::string& task)
+    {
+        havGSDTestFile& file = mFiles[fileIndex];
+        file.mContent += "// " + task + "\n";
+        havGSDTestDirectory::WriteFileAt(file.mPath, file.mContent);
+        return file.mPath;
+    }
+
+    bool RenameFile(int fileIndex, const wxString& newPath)
+    {
+        havGSDTestFile& file = mFiles[fileIndex];
+
+        if (!wxRenameFile(file.mPath, newPath, false))
+        {
+            return false;
+        }
+
+        file.mPath = newPath;
+        UpdateProjectFiles();
+        return true;
+    }
+
+    // Rows of the task list in the list view, each as "type, description, project, file, line" separated by tabs, sorted
+    std::vector<wxString> GetExpectedRows() const
+    {
+        std::vector<wxString> rows;
+
+        for (const havGSDTestFile& file : mFiles)
+        {
+            const wxString fileName = wxFileName(file.mPath).GetFullName();
+
+            std::size_t lineStart = 0;
+            std::size_t lineNumber = 1;
+
+            while (lineStart < file.mContent.size())
+            {
+                std::size_t lineEnd = file.mContent.find('\n', lineStart);
+                const std::string line = file.mContent.substr(lineStart, lineEnd - lineStart);
+
+                if (line.compare(0, 3, "// ") == 0)
+                {
+                    const std::string keyword = line.substr(3, line.find(' ', 3) - 3);
+                    rows.push_back(wxString::Format("%s\t%s\t%s\t%s\t%zu", wxString::FromUTF8(keyword.data(), keyword.size()), wxString::FromUTF8(line.data(), line.size()), mProject->GetName(), fileName, lineNumber));
+                }
+
+                lineStart = lineEnd + 1;
+                ++lineNumber;
+            }
+        }
+
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+private:
+    struct havGSDTestFile
+    {
+        wxString mPath;
+        std::string mContent;
+    };
+
+    static std::string GetFileContent(int fileIndex)
+    {
+        static const char* const keywords[] = { "TODO", "FIXME", "HACK", "NOTE" };
+
+        std::string content;
+
+        for (int line = 1; line <= LineCount; ++line)
+        {
+            const std::string number = std::to_string(line);
+
+            if (line % 50 == 10)
+            {
+                content += std::string("// ") + keywords[(line / 50) % 4] + " task " + std::to_string(fileIndex) + "." + number + "\n";
+            }
+            else if (line % 50 == 30)
+            {
+                content += "const char* label" + number + " = \"TODO outside of a comment\";\n";
+            }
+            else
+            {
+                content += "int value" + number + " = " + number + ";\n";
+            }
+        }
+
+        return content;
+    }
+
+    void UpdateProjectFiles()
+    {
+        std::vector<wxFileName> files;
+
+        for (const havGSDTestFile& file : mFiles)
+        {
+            files.push_back(wxFileName(file.mPath));
+        }
+
+        mProject->SetFiles(files);
+    }
+
+    ProjectPtr mProject;
+    std::vector<havGSDTestFile> mFiles;
+};
+
+// Sends the events of CodeLite to the real plugin and measures the time until the task list shows the expected rows
+class havGSDLatencyTest
+{
+public:
+    static constexpr long TimeoutMs = 30000;
+
+    havGSDLatencyTest(wxFrame* frame, int eventCount)
+        : mEventCount(eventCount), mManager(frame), mFirstProject(mDirectory, "first", 150), mSecondProject(mDirectory, "second", 100)
+    {
+        clStandardPaths::Get().SetUserDataDir(mDirectory.GetFilePath("userdata"));
+
+        mManager.GetTestWorkspace().SetActiveProject(mFirstProject.GetProject());
+        mManager.OpenEditor(wxFileName(mFirstProject.GetFilePath(0)));
+        mActiveProject = &mFirstProject;
+
+        mPlugin.reset(CreatePlugin(&mManager));
+    }
+
+    ~havGSDLatencyTest()
+    {
+        mPlugin->UnPlug();
+        mPlugin.reset();
+    }
+
+    void Run()
+    {
+        for (int eventIndex = 0; eventIndex < mEventCount; ++eventIndex)
+        {
+            clWorkspaceEvent event(wxEVT_WORKSPACE_LOADED);
+            event.SetWorkspaceType("C++");
+            Measure("WorkspaceOpened", event);
+        }
+
+        for (int eventIndex = 0; eventIndex < mEventCount; ++eventIndex)
+        {
+            // The files are saved in turn, like editing across the project
+            const int fileIndex = eventIndex % mActiveProject->GetFileCount();
+
+            clCommandEvent event(wxEVT_FILE_SAVED);
+            event.SetFileName(mActiveProject->SaveFile(fileIndex, "FIXME saved " + std::to_string(eventIndex)));
+            Measure("FileSaved", event);
+        }
+
+        for (int eventIndex = 0; eventIndex < mEventCount; ++eventIndex)
+        {
+            const int fileIndex = eventIndex % mActiveProject->GetFileCount();
+            const wxString path = mActiveProject->GetFilePath(fileIndex);
+            const wxString newPath = wxFileName(path).GetPathWithSep() + wxString::Format("renamed%d.cpp", eventIndex);
+
+            HAVGSD_CHECK(mActiveProject->RenameFile(fileIndex, newPath));
+
+            clFileSystemEvent event(wxEVT_FILE_RENAMED);
+            event.SetPath(path);
+            event.SetNewpath(newPath);
+            Measure("FileRenamed", event);
+        }
+
+        for (int eventIndex = 0; eventIndex < mEventCount; ++eventIndex)
+        {
+            mActiveProject = (mActiveProject == &mFirstProject) ? &mSecondProject : &mFirstProject;
+            mManager.GetTestWorkspace().SetActiveProject(mActiveProject->GetProject());
+
+            clProjectSettingsEvent event(wxEVT_ACTIVE_PROJECT_CHANGED);
+            event.SetProjectName(mActiveProject->GetProject()->GetName());
+            Measure("ActiveProjectChanged", event);
+        }
+    }
+
+    // Prints p50 and p99 per event, a p99 above the budget fails the test
+    void Report(long budgetMs) const
+    {
+        for (const auto& [eventName, latencies] : mLatencies)
+        {
+            const double median = GetPercentile(latencies, 50) / 1000.0;
+            const double percentile99 = GetPercentile(latencies, 99) / 1000.0;
+
+            std::printf("%-22s p50 %8.1f ms, p99 %8.1f ms over %zu events\n", eventName.c_str(), median, percentile99, latencies.size());
+            std::fflush(stdout);
+
+            if (percentile99 > budgetMs)
+            {
+                std::fprintf(stderr, "%s: p99 of %.1f ms is above the budget of %ld ms\n", eventName.c_str(), percentile99, budgetMs);
+            }
+
+            HAVGSD_CHECK(percentile99 <= budgetMs);
+        }
+    }
+
+private:
+    void Measure(const std::string& eventName, wxEvent& event)
+    {
+        const std::vector<wxString> expectedRows = mActiveProject->GetExpectedRows();
+
+        wxStopWatch stopWatch;
+
+        EventNotifier::Get()->ProcessEvent(event);
+
+        // Handle the results posted by the scan thread, like the main loop of CodeLite, until the final rows are shown
+        // - The task list is polled every millisecond, which is part of the measured latency
+        bool shown = IsShown(expectedRows);
+
+        while (!shown && stopWatch.Time() < TimeoutMs)
+        {
+            wxMilliSleep(1);
+            ProcessEvents();
+
+            shown = IsShown(expectedRows);
+        }
+
+        const long long latency = stopWatch.TimeInMicro().GetValue();
+
+        if (!shown)
+        {
+            std::fprintf(stderr, "%s: the task list didn't show the %zu expected tasks within %ld ms\n", eventName.c_str(), expectedRows.size(), TimeoutMs);
+        }
+
+        HAVGSD_CHECK(shown);
+
+        if (shown)
+        {
+            mLatencies[eventName].push_back(latency);
+        }
+
+        // The next event comes after the scan finished, like the next save of a user
+        stopWatch.Start();
+
+        while (stopWatch.Time() < 20)
+        {
+            wxMilliSleep(1);
+            ProcessEvents();
+        }
+    }
+
+    static void ProcessEvents()
+    {
+        wxEventLoopBase::GetActive()->Yield(true);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    bool IsShown(const std::vector<wxString>& expectedRows)
+    {
+        wxDataViewCtrl* taskList = FindTaskList(mManager.GetMainPanel());
+        wxDataViewListModel* model = taskList ? dynamic_cast<wxDataViewListModel*>(taskList->GetModel()) : nullptr;
+
+        if (!model || static_cast<std::size_t>(model->GetCount()) != expectedRows.size())
+        {
+            return false;
+        }
+
+        std::vector<wxString> rows;
+
+        for (unsigned int row = 0; row < model->GetCount(); ++row)
+        {
+            wxString text;
+
+            for (unsigned int column = 0; column < 5; ++column)
+            {
+                wxVariant value;
+                model->GetValueByRow(value, row, column);
+                text += (column > 0 ? "\t" : "") + value.GetString();
+            }
+
+            rows.push_back(text);
+        }
+
+        // The order of the scan isn't checked
+        std::sort(rows.begin(), rows.end());
+        return rows == expectedRows;
+    }
+
+    // The task list is private to the plugin, it's found among the windows of its panel
+    static wxDataViewCtrl* FindTaskList(wxWindow* window)
+    {
+        for (wxWindow* child : window->GetChildren())
+        {
+            if (wxDataViewCtrl* taskList = dynamic_cast<wxDataViewCtrl*>(child))
+            {
+                return taskList;
+            }
+
+            if (wxDataViewCtrl* taskList = FindTaskList(child))
+            {
+                return taskList;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Nearest-rank percentile, like havGSDLatencyTracker
+    static long long GetPercentile(std::vector<long long> latencies, std::size_t percentile)
+    {
+        const std::size_t rank = (percentile * latencies.size() + 99) / 100;
+        const std::size_t index = (rank > 0) ? rank - 1 : 0;
+
+        std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+
+        return latencies[index];
+    }
+
+    int mEventCount;
+    havGSDTestDirectory mDirectory;
+    havGSDTestManager mManager;
+    havGSDTestProject mFirstProject;
+    havGSDTestProject mSecondProject;
+    havGSDTestProject* mActiveProject;
+    std::unique_ptr<IPlugin> mPlugin;
+
+    // Microseconds per event
+    std::map<std::string, std::vector<long long>> mLatencies;
+};
+
+// Usage: havGSDLatencyTest [events per kind] [p99 budget in ms]
+int main(int argc, char** argv)
+{
+    wxApp::SetInstance(new wxApp());
+
+    // The task list needs a display
+    if (!wxEntryStart(argc, argv))
+    {
+        std::printf("havGSDLatencyTest: skipped, wxWidgets couldn't be initialized\n");
+        return SkippedExitCode;
+    }
+
+    long eventCount = 20;
+    long budgetMs = 1000;
+
+    if ((argc > 1 && !wxString(argv[1]).ToLong(&eventCount)) || (argc > 2 && !wxString(argv[2]).ToLong(&budgetMs)) || eventCount < 1)
+    {
+        std::fprintf(stderr, "usage: havGSDLatencyTest [events per kind] [p99 budget in ms]\n");
+        wxEntryCleanup();
+        return 2;
+    }
+
+    {
+        wxEventLoop eventLoop;
+        wxEventLoopActivator eventLoopActivator(&eventLoop);
+
+        // Never shown, the task list is only read back
+        wxFrame* frame = new wxFrame(nullptr, wxID_ANY, "havGSDLatencyTest");
+        wxTheApp->SetTopWindow(frame);
+
+        {
+            havGSDLatencyTest latencyTest(frame, static_cast<int>(eventCount));
+            latencyTest.Run();
+            latencyTest.Report(budgetMs);
+        }
+
+        // Deleted with the pending objects, when wxWidgets is cleaned up
+        frame->Destroy();
+    }
+
+    EventNotifier::Release();
+    wxEntryCleanup();
+
+    return havGSDTest::Finish("havGSDLatencyTest");
+}
@@ -0,0 +1,265 @@
+/*
+havGSDTaskIndexTest.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "havGSDTaskIndex.hpp"
+#include "havGSDTaskSortKeys.hpp"
+#include "havGSDTest.hpp"
+
+#include <wx/init.h>
+
+#include <vector>
+
+static havGSDFileItem MakeFileItem(const wxString& type, const wxString& filePath, const wxString& description, int line)
+{
+    havGSDFileItem fileItem;
+    fileItem.mType = type;
+    fileItem.mProjectName = filePath.BeforeFirst('/');
+    fileItem.mFileName = filePath.AfterLast('/');
+    fileItem.mFilePath = filePath;
+    fileItem.mDescription = description;
+    fileItem.mLine = wxString::Format("%d", line);
+    return fileItem;
+}
+
+static std::vector<havGSDFileItem> MakeFileItems(const wxString& filePath, int count, const wxString& description)
+{
+    const wxString types[] = { "TODO", "FIXME", "HACK" };
+
+    std::vector<havGSDFileItem> fileItems;
+
+    for (int index = 0; index < count; ++index)
+    {
+        fileItems.push_back(MakeFileItem(types[index % 3], filePath, wxString::Format("%s todo(ann) %d", description, index), 10 * (count - index)));
+    }
+
+    return fileItems;
+}
+
+// Replaces the items of the files like havGSD::RescanFilesInResults(), the new items take the place of the first replaced item
+static std::vector<havGSDFileItem> Replace(const std::vector<havGSDFileItem>& baseFileItems, const std::vector<wxString>& filePaths,
+                                           const std::vector<havGSDFileItem>& newFileItems, havGSDTaskIndex::ItemIds& baseItemIds)
+{
+    std::vector<havGSDFileItem> fileItems;
+    bool newFileItemsAdded = false;
+
+    auto addNewFileItems = [&]() {
+        fileItems.insert(fileItems.end(), newFileItems.begin(), newFileItems.end());
+        baseItemIds.insert(baseItemIds.end(), newFileItems.size(), havGSDTaskIndex::NewItemId);
+        newFileItemsAdded = true;
+    };
+
+    for (std::uint32_t baseItemId = 0; baseItemId < baseFileItems.size(); ++baseItemId)
+    {
+        if (std::find(filePaths.begin(), filePaths.end(), baseFileItems[baseItemId].mFilePath) == filePaths.end())
+        {
+            fileItems.push_back(baseFileItems[baseItemId]);
+            baseItemIds.push_back(baseItemId);
+        }
+        else if (!newFileItemsAdded)
+        {
+            addNewFileItems();
+        }
+    }
+
+    if (!newFileItemsAdded)
+    {
+        addNewFileItems();
+    }
+
+    return fileItems;
+}
+
+// The updated index and keys must answer like the ones built from scratch
+static void CheckUpdate(const std::vector<havGSDFileItem>& baseFileItems, const std::vector<wxString>& filePaths, const std::vector<havGSDFileItem>& newFileItems)
+{
+    havGSDTaskIndex baseTaskIndex;
+    baseTaskIndex.Build(baseFileItems);
+
+    havGSDTaskSortKeys baseSortKeys;
+    baseSortKeys.Build(baseFileItems);
+
+    havGSDTaskIndex::ItemIds baseItemIds;
+    const std::vector<havGSDFileItem> fileItems = Replace(baseFileItems, filePaths, newFileItems, baseItemIds);
+
+    havGSDTaskIndex builtTaskIndex;
+    builtTaskIndex.Build(fileItems);
+
+    havGSDTaskIndex updatedTaskIndex;
+    updatedTaskIndex.Update(baseTaskIndex, fileItems, baseItemIds);
+
+    const wxString filters[] = { "", "alpha", "ALPHA 1", "gamma", "type:todo", "type:fix type:hack", "file:b.cpp", "file:/c", "project:p2",
+                                 "owner:ann", "owner:bob", "type:todo file:a.cpp alp", "zzz" };
+
+    for (const wxString& filter : filters)
+    {
+        HAVGSD_CHECK(updatedTaskIndex.Query(filter) == builtTaskIndex.Query(filter));
+    }
+
+    const wxString types[] = { "", "TODO", "FIXME", "HACK", "NOTE" };
+    const wxString groupFilePaths[] = { "", "p1/a.cpp", "p1/b.cpp", "p2/c.cpp", "p2/d.cpp", "p1/A.cpp" };
+
+    for (const wxString& type : types)
+    {
+        for (const wxString& filePath : groupFilePaths)
+        {
+            HAVGSD_CHECK(updatedTaskIndex.Find(type, filePath) == builtTaskIndex.Find(type, filePath));
+        }
+    }
+
+    havGSDTaskSortKeys builtSortKeys;
+    builtSortKeys.Build(fileItems);
+
+    havGSDTaskSortKeys updatedSortKeys;
+    updatedSortKeys.Update(baseSortKeys, fileItems, baseItemIds);
+
+    const std::vector<std::vector<havGSDSortKey>> sorts = {
+        { { havGSDSortColumn::Type, true } },
+        { { havGSDSortColumn::FileName, false }, { havGSDSortColumn::Line, true } },
+        { { havGSDSortColumn::Project, true }, { havGSDSortColumn::FilePath, false }, { havGSDSortColumn::Type, true } },
+        { { havGSDSortColumn::Line, false } },
+    };
+
+    for (const auto& sort : sorts)
+    {
+        havGSDTaskIndex::ItemIds builtItemIds = builtTaskIndex.Query("");
+        havGSDTaskIndex::ItemIds updatedItemIds = builtItemIds;
+
+        builtSortKeys.Sort(builtItemIds, sort);
+        updatedSortKeys.Sort(updatedItemIds, sort);
+
+        HAVGSD_CHECK(updatedItemIds == builtItemIds);
+    }
+}
+
+static std::vector<havGSDFileItem> MakeBaseFileItems()
+{
+    std::vector<havGSDFileItem> fileItems;
+
+    for (const auto& [filePath, description] : { std::make_pair("p1/a.cpp", "Alpha"), std::make_pair("p1/b.cpp", "Beta"), std::make_pair("p2/c.cpp", "Gamma") })
+    {
+        const std::vector<havGSDFileItem> fileItemsOfFile = MakeFileItems(filePath, 7, description);
+        fileItems.insert(fileItems.end(), fileItemsOfFile.begin(), fileItemsOfFile.end());
+    }
+
+    return fileItems;
+}
+
+static void TestUpdate()
+{
+    const std::vector<havGSDFileItem> baseFileItems = MakeBaseFileItems();
+
+    // Same values, other descriptions
+    CheckUpdate(baseFileItems, { "p1/b.cpp" }, MakeFileItems("p1/b.cpp", 4, "Gamma"));
+
+    // More items than before
+    CheckUpdate(baseFileItems, { "p1/a.cpp" }, MakeFileItems("p1/a.cpp", 12, "Alphabet"));
+
+    // The file has no tasks left, its group and values go away
+    CheckUpdate(baseFileItems, { "p2/c.cpp" }, {});
+
+    // A new file, a new project and a new keyword rank between the values of the base
+    std::vector<havGSDFileItem> newFileItems = MakeFileItems("p1/A.cpp", 3, "Delta");
+    newFileItems.push_back(MakeFileItem("NOTE", "p0/aa.cpp", "Epsilon todo(bob)", 5));
+    CheckUpdate(baseFileItems, { "p1/A.cpp", "p0/aa.cpp" }, newFileItems);
+
+    // Several files at once
+    CheckUpdate(baseFileItems, { "p1/a.cpp", "p2/c.cpp" }, MakeFileItems("p2/c.cpp", 2, "Alpha"));
+}
+
+static void TestRepeatedUpdates()
+{
+    // Each rescan builds on the results of the one before, like saving a file again and again
+    std::vector<havGSDFileItem> fileItems = MakeBaseFileItems();
+
+    havGSDTaskIndex taskIndex;
+    taskIndex.Build(fileItems);
+
+    havGSDTaskSortKeys sortKeys;
+    sortKeys.Build(fileItems);
+
+    for (int rescan = 0; rescan < 10; ++rescan)
+    {
+        const wxString filePath = (rescan % 2 == 0) ? "p1/b.cpp" : "p3/e.cpp";
+
+        havGSDTaskIndex::ItemIds baseItemIds;
+        std::vector<havGSDFileItem> nextFileItems = Replace(fileItems, { filePath }, MakeFileItems(filePath, rescan % 4, wxString::Format("Rescan%d", rescan)), baseItemIds);
+
+        havGSDTaskIndex nextTaskIndex;
+        nextTaskIndex.Update(taskIndex, nextFileItems, baseItemIds);
+
+        havGSDTaskSortKeys nextSortKeys;
+        nextSortKeys.Update(sortKeys, nextFileItems, baseItemIds);
+
+        fileItems.swap(nextFileItems);
+        taskIndex = std::move(nextTaskIndex);
+        sortKeys = std::move(nextSortKeys);
+    }
+
+    havGSDTaskIndex builtTaskIndex;
+    builtTaskIndex.Build(fileItems);
+
+    havGSDTaskSortKeys builtSortKeys;
+    builtSortKeys.Build(fileItems);
+
+    for (const wxString& filter : { "", "rescan9", "file:e.cpp", "type:todo beta", "owner:ann" })
+    {
+        HAVGSD_CHECK(taskIndex.Query(filter) == builtTaskIndex.Query(filter));
+    }
+
+    havGSDTaskIndex::ItemIds builtItemIds = builtTaskIndex.Query("");
+    havGSDTaskIndex::ItemIds itemIds = builtItemIds;
+    const std::vector<havGSDSortKey> sort = { { havGSDSortColumn::FilePath, false }, { havGSDSortColumn::Line, true } };
+
+    builtSortKeys.Sort(builtItemIds, sort);
+    sortKeys.Sort(itemIds, sort);
+
+    HAVGSD_CHECK(itemIds == builtItemIds);
+}
+
+int main()
+{
+    wxInitializer initializer;
+
+    TestUpdate();
+    TestRepeatedUpdates();
+
+    return havGSDTest::Finish("havGSDTaskIndexTest");
+}
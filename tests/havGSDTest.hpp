@@ -0,0 +1,145 @@
+/*
+havGSDTest.hpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSDTEST_HPP
+#define HAVGSDTEST_HPP
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+#include <wx/utils.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+// Checks of the tests, each test is a program which fails if a check failed
+class havGSDTest
+{
+public:
+    static void Fail(const char* file, int line, const char* condition)
+    {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+        ++GetFailureCount();
+    }
+
+    // Exit code of the test program
+    static int Finish(const char* testName)
+    {
+        if (GetFailureCount() > 0)
+        {
+            std::fprintf(stderr, "%s: %d checks failed\n", testName, GetFailureCount());
+            return 1;
+        }
+
+        std::printf("%s: all checks passed\n", testName);
+        return 0;
+    }
+
+private:
+    static int& GetFailureCount()
+    {
+        static int failureCount = 0;
+        return failureCount;
+    }
+};
+
+#define HAVGSD_CHECK(condition)                                 \
+    do                                                          \
+    {                                                           \
+        if (!(condition))                                       \
+        {                                                       \
+            havGSDTest::Fail(__FILE__, __LINE__, #condition);   \
+        }                                                       \
+    } while (false)
+
+// Directory of a test below the temporary directory, removed with everything in it
+class havGSDTestDirectory
+{
+public:
+    havGSDTestDirectory()
+    {
+        static std::atomic<int> directoryCount(0);
+
+        mPath = wxFileName(wxFileName::GetTempDir(), wxString::Format("havgsd-test-%lu-%d", wxGetProcessId(), ++directoryCount)).GetFullPath();
+
+        wxFileName::Rmdir(mPath, wxPATH_RMDIR_RECURSIVE);
+        wxFileName::Mkdir(mPath, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    }
+
+    ~havGSDTestDirectory() { wxFileName::Rmdir(mPath, wxPATH_RMDIR_RECURSIVE); }
+
+    havGSDTestDirectory(const havGSDTestDirectory&) = delete;
+    havGSDTestDirectory& operator=(const havGSDTestDirectory&) = delete;
+
+    const wxString& GetPath() const { return mPath; }
+
+    // Full path of a file given relative to the directory with '/' as separator
+    wxString GetFilePath(const wxString& relativePath) const
+    {
+        wxString filePath = mPath + "/" + relativePath;
+        filePath.Replace("/", wxFileName::GetPathSeparator());
+        return filePath;
+    }
+
+    // Writes the file and the directories leading to it
+    wxString WriteFile(const wxString& relativePath, const std::string& content) const
+    {
+        const wxString filePath = GetFilePath(relativePath);
+        WriteFileAt(filePath, content);
+        return filePath;
+    }
+
+    static bool WriteFileAt(const wxString& filePath, const std::string& content)
+    {
+        wxFileName::Mkdir(wxFileName(filePath).GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+
+        wxFile file;
+        return file.Create(filePath, true) && (content.empty() || file.Write(content.data(), content.size()) == content.size());
+    }
+
+private:
+    wxString mPath;
+};
+
+#endif
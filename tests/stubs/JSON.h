@@ -0,0 +1,192 @@
+/*
+JSON.h
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSD_STUB_JSON_H
+#define HAVGSD_STUB_JSON_H
+
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#define cJSON_Object 6
+
+// Stand-in for CodeLite's JSON item, values are kept as text and items refer to the nodes of their document
+class JSONItem
+{
+public:
+    JSONItem() = default;
+
+    static JSONItem createObject() { return JSONItem(std::make_shared<Node>()); }
+
+    JSONItem& addProperty(const wxString& name, const wxString& value) { return AddProperty(name, value); }
+    JSONItem& addProperty(const wxString& name, const char* value) { return AddProperty(name, wxString(value)); }
+    JSONItem& addProperty(const wxString& name, bool value) { return AddProperty(name, value ? "true" : "false"); }
+    JSONItem& addProperty(const wxString& name, int value) { return AddProperty(name, wxString::Format("%d", value)); }
+
+    JSONItem AddArray(const wxString& name)
+    {
+        JSONItem array = createObject();
+
+        if (mNode)
+        {
+            mNode->mProperties.push_back({ name, array.mNode });
+        }
+
+        return array;
+    }
+
+    void arrayAppend(const JSONItem& item)
+    {
+        if (mNode && item.mNode)
+        {
+            mNode->mElements.push_back(item.mNode);
+        }
+    }
+
+    JSONItem operator[](const wxString& name) const
+    {
+        if (mNode)
+        {
+            for (const auto& property : mNode->mProperties)
+            {
+                if (property.first == name)
+                {
+                    return JSONItem(property.second);
+                }
+            }
+        }
+
+        return JSONItem();
+    }
+
+    JSONItem operator[](int index) const
+    {
+        if (!mNode || index < 0 || index >= arraySize())
+        {
+            return JSONItem();
+        }
+
+        return JSONItem(mNode->mElements[index]);
+    }
+
+    int arraySize() const { return mNode ? static_cast<int>(mNode->mElements.size()) : 0; }
+
+    wxString toString(const wxString& defaultValue = wxEmptyString) const { return mNode ? mNode->mValue : defaultValue; }
+    bool toBool(bool defaultValue = false) const { return mNode ? mNode->mValue == "true" : defaultValue; }
+
+    int toInt(int defaultValue = -1) const
+    {
+        long value = 0;
+        return (mNode && mNode->mValue.ToLong(&value)) ? static_cast<int>(value) : defaultValue;
+    }
+
+    bool isOk() const { return mNode != nullptr; }
+
+private:
+    struct Node
+    {
+        wxString mValue;
+        std::vector<std::pair<wxString, std::shared_ptr<Node>>> mProperties;
+        std::vector<std::shared_ptr<Node>> mElements;
+    };
+
+    explicit JSONItem(std::shared_ptr<Node> node) : mNode(std::move(node)) {}
+
+    JSONItem& AddProperty(const wxString& name, const wxString& value)
+    {
+        if (mNode)
+        {
+            std::shared_ptr<Node> node = std::make_shared<Node>();
+            node->mValue = value;
+            mNode->mProperties.push_back({ name, node });
+        }
+
+        return *this;
+    }
+
+    std::shared_ptr<Node> mNode;
+};
+
+// Stand-in for CodeLite's JSON document, saved documents are kept in memory and only an empty file is written,
+// so the settings find their file on the next load
+class JSON
+{
+public:
+    explicit JSON(int type) : mRoot(JSONItem::createObject()) { wxUnusedVar(type); }
+
+    explicit JSON(const wxFileName& fileName)
+    {
+        auto document = GetSavedDocuments().find(fileName.GetFullPath());
+
+        if (document != GetSavedDocuments().end() && fileName.FileExists())
+        {
+            mRoot = document->second;
+        }
+    }
+
+    JSONItem toElement() const { return mRoot; }
+
+    void save(const wxFileName& fileName) const
+    {
+        GetSavedDocuments()[fileName.GetFullPath()] = mRoot;
+
+        wxFile file;
+        file.Create(fileName.GetFullPath(), true);
+    }
+
+    bool isOk() const { return mRoot.isOk(); }
+
+private:
+    static std::map<wxString, JSONItem>& GetSavedDocuments()
+    {
+        static std::map<wxString, JSONItem> savedDocuments;
+        return savedDocuments;
+    }
+
+    JSONItem mRoot;
+};
+
+#endif
@@ -0,0 +1,66 @@
+/*
+clFileSystemEvent.h
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSD_STUB_CLFILESYSTEMEVENT_H
+#define HAVGSD_STUB_CLFILESYSTEMEVENT_H
+
+#include "cl_command_event.h"
+
+// Stand-in for CodeLite's file system event, the new path is only set for renamed files
+class clFileSystemEvent : public clCommandEvent
+{
+public:
+    clFileSystemEvent(wxEventType commandType = wxEVT_NULL, int winid = 0) : clCommandEvent(commandType, winid) {}
+
+    wxEvent* Clone() const override { return new clFileSystemEvent(*this); }
+
+    void SetPath(const wxString& path) { mPath = path; }
+    const wxString& GetPath() const { return mPath; }
+
+    void SetNewpath(const wxString& newPath) { mNewPath = newPath; }
+    const wxString& GetNewpath() const { return mNewPath; }
+
+private:
+    wxString mPath;
+    wxString mNewPath;
+};
+
+#endif
@@ -0,0 +1,98 @@
+/*
+clThemedListCtrl.h
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSD_STUB_CLTHEMEDLISTCTRL_H
+#define HAVGSD_STUB_CLTHEMEDLISTCTRL_H
+
+#include <wx/bitmap.h>
+#include <wx/colour.h>
+#include <wx/dataview.h>
+#include <wx/variant.h>
+#include <wx/vector.h>
+
+// Stand-in for CodeLite's list control, a list of text columns, whose rows are read back by the tests
+class clThemedListCtrl : public wxDataViewListCtrl
+{
+public:
+    clThemedListCtrl(wxWindow* parent, wxWindowID id, const wxPoint& pos = wxDefaultPosition, const wxSize& size = wxDefaultSize, long style = wxDV_ROW_LINES | wxDV_SINGLE)
+        : wxDataViewListCtrl(parent, id, pos, size, style)
+    {
+    }
+
+    void AddHeader(const wxString& label, const wxBitmap& bitmap = wxNullBitmap, int width = wxCOL_WIDTH_AUTOSIZE)
+    {
+        wxUnusedVar(bitmap);
+        AppendTextColumn(label, wxDATAVIEW_CELL_INERT, width);
+    }
+
+    wxDataViewItem AppendItem(const wxVector<wxVariant>& values, wxUIntPtr data = 0)
+    {
+        wxDataViewListCtrl::AppendItem(values, data);
+        return RowToItem(GetItemCount() - 1);
+    }
+
+    // The other columns are left empty
+    wxDataViewItem AppendItem(const wxString& text)
+    {
+        wxVector<wxVariant> values;
+        values.push_back(text);
+
+        for (unsigned int column = 1; column < GetColumnCount(); ++column)
+        {
+            values.push_back(wxString());
+        }
+
+        return AppendItem(values);
+    }
+
+    wxString GetItemText(const wxDataViewItem& item, unsigned int column = 0) const { return GetTextValue(ItemToRow(item), column); }
+    void SetItemText(const wxDataViewItem& item, const wxString& text, unsigned int column = 0) { SetTextValue(text, ItemToRow(item), column); }
+
+    // Colors aren't checked by the tests
+    void SetItemTextColour(const wxDataViewItem& item, const wxColour& colour, unsigned int column = 0)
+    {
+        wxUnusedVar(item);
+        wxUnusedVar(colour);
+        wxUnusedVar(column);
+    }
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+codelite_events.cpp
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "codelite_events.h"
+
+wxDEFINE_EVENT(wxEVT_WORKSPACE_LOADED, clWorkspaceEvent);
+wxDEFINE_EVENT(wxEVT_WORKSPACE_CLOSED, clWorkspaceEvent);
+wxDEFINE_EVENT(wxEVT_ACTIVE_PROJECT_CHANGED, clProjectSettingsEvent);
+wxDEFINE_EVENT(wxEVT_PROJ_RENAMED, clCommandEvent);
+wxDEFINE_EVENT(wxEVT_PROJ_REMOVED, clCommandEvent);
+wxDEFINE_EVENT(wxEVT_FILE_SAVED, clCommandEvent);
+wxDEFINE_EVENT(wxEVT_FILE_RENAMED, clFileSystemEvent);
+wxDEFINE_EVENT(wxEVT_FILE_DELETED, clFileSystemEvent);
+wxDEFINE_EVENT(wxEVT_BUILD_STARTED, clBuildEvent);
+wxDEFINE_EVENT(wxEVT_BUILD_ENDED, clBuildEvent);
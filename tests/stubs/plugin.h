@@ -0,0 +1,99 @@
+/*
+plugin.h
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSD_STUB_PLUGIN_H
+#define HAVGSD_STUB_PLUGIN_H
+
+#include <wx/event.h>
+#include <wx/menu.h>
+#include <wx/string.h>
+
+#include "cl_standard_paths.h"
+#include "imanager.h"
+
+#define CL_PLUGIN_API extern "C"
+#define PLUGIN_INTERFACE_VERSION 1
+
+#define CHECK_ITEM_RET(item) \
+    if (!(item).IsOk())      \
+    {                        \
+        return;              \
+    }
+
+class clToolBarGeneric;
+
+// Stand-in for the plugin information of CodeLite
+class PluginInfo
+{
+public:
+    void SetAuthor(const wxString& author) { mAuthor = author; }
+    void SetName(const wxString& name) { mName = name; }
+    void SetDescription(const wxString& description) { mDescription = description; }
+    void SetVersion(const wxString& version) { mVersion = version; }
+
+private:
+    wxString mAuthor;
+    wxString mName;
+    wxString mDescription;
+    wxString mVersion;
+};
+
+// Stand-in for the plugin interface of CodeLite
+class IPlugin : public wxEvtHandler
+{
+public:
+    explicit IPlugin(IManager* manager) : m_mgr(manager) {}
+    virtual ~IPlugin() {}
+
+    virtual void CreateToolBar(clToolBarGeneric* toolbar) = 0;
+    virtual void CreatePluginMenu(wxMenu* pluginsMenu) = 0;
+    virtual void UnPlug() = 0;
+
+    const wxString& GetShortName() const { return m_shortName; }
+    const wxString& GetLongName() const { return m_longName; }
+
+protected:
+    IManager* m_mgr;
+    wxString m_shortName;
+    wxString m_longName;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/*
+project.h
+
+ABOUT
+
+Havoc's Task List Plugin for C++ Projects in CodeLite.
+
+TODO
+
+- Improve error handling.
+- Add support for externally modified files.
+
+REVISION HISTORY
+
+v0.1 (2025-03-02) - First release.
+
+LICENSE
+
+MIT License
+
+Copyright (c) 2025 René Nicolaus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HAVGSD_STUB_PROJECT_H
+#define HAVGSD_STUB_PROJECT_H
+
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <memory>
+#include <vector>
+
+// Stand-in for a project of CodeLite, the test sets the files, like adding them in the workspace view
+class Project
+{
+public:
+    Project(const wxString& name, const wxFileName& fileName) : mName(name), mFileName(fileName) {}
+
+    const wxString& GetName() const { return mName; }
+    const wxFileName& GetFileName() const { return mFileName; }
+
+    // The files are always absolute
+    void GetFilesAsVectorOfFileName(std::vector<wxFileName>& files, bool absPath = true) const
+    {
+        wxUnusedVar(absPath);
+        files.insert(files.end(), mFiles.begin(), mFiles.end());
+    }
+
+    void SetFiles(const std::vector<wxFileName>& files) { mFiles = files; }
+
+private:
+    wxString mName;
+    wxFileName mFileName;
+    std::vector<wxFileName> mFiles;
+};
+
+typedef std::shared_ptr<Project> ProjectPtr;
+
+#endif